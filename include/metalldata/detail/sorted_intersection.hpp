@@ -0,0 +1,63 @@
+// Copyright Lawrence Livermore National Security, LLC and other MetallData
+// Project Developers. See the top-level COPYRIGHT file for details.
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+#include <algorithm>
+#include <span>
+#include <utility>
+
+namespace metalldata {
+
+/**
+ * @brief Calls f for each element common to the sorted ranges a and b.  Gallops
+ * through the longer range when the sizes are lopsided, merges otherwise.
+ */
+template <typename T, typename Fn>
+void for_each_common(std::span<const T> a, std::span<const T> b, Fn f) {
+  if (a.size() > b.size()) {
+    std::swap(a, b);
+  }
+  if (a.empty()) {
+    return;
+  }
+
+  if (a.size() * 32 < b.size()) {
+    auto lo = b.begin();
+    for (const auto& x : a) {
+      // Exponential search for the first element >= x, then binary search.
+      size_t step = 1;
+      auto   hi = lo;
+      while (hi != b.end() && *hi < x) {
+        lo = hi;
+        hi = (size_t(b.end() - hi) > step) ? hi + step : b.end();
+        step *= 2;
+      }
+      lo = std::lower_bound(lo, hi, x);
+      if (lo == b.end()) {
+        return;
+      }
+      if (*lo == x) {
+        f(x);
+      }
+    }
+    return;
+  }
+
+  auto ia = a.begin();
+  auto ib = b.begin();
+  while (ia != a.end() && ib != b.end()) {
+    if (*ia < *ib) {
+      ++ia;
+    } else if (*ib < *ia) {
+      ++ib;
+    } else {
+      f(*ia);
+      ++ia;
+      ++ib;
+    }
+  }
+}
+
+}  // namespace metalldata
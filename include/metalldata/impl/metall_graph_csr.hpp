@@ -0,0 +1,202 @@
+// Copyright Lawrence Livermore National Security, LLC and other MetallData
+// Project Developers. See the top-level COPYRIGHT file for details.
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+#include <metalldata/metall_graph.hpp>
+#include <algorithm>
+#include <memory>
+#include <span>
+#include <utility>
+#include <vector>
+#include <boost/container/vector.hpp>
+
+namespace metalldata {
+
+/**
+ * @brief Read-only view of a rank-local CSR adjacency.  Rows are indexed by
+ * local_node_idx_type; each entry is a neighbor node_locator and the
+ * edge_locator of the edge that produced it.  Neighbors within a row are
+ * sorted.
+ *
+ */
+class metall_graph::csr_view {
+ public:
+  csr_view() = default;
+
+  csr_view(std::span<const size_t> offsets, std::span<const node_locator> nbrs,
+           std::span<const edge_locator> edges)
+      : m_offsets(offsets), m_nbrs(nbrs), m_edges(edges) {}
+
+  size_t num_rows() const {
+    return m_offsets.empty() ? 0 : m_offsets.size() - 1;
+  }
+
+  size_t num_entries() const { return m_nbrs.size(); }
+
+  /// Position of the first entry of row nid, for per-entry side arrays
+  size_t offset(local_node_idx_type nid) const {
+    auto i = std::to_underlying(nid);
+    return i < num_rows() ? m_offsets[i] : num_entries();
+  }
+
+  size_t degree(local_node_idx_type nid) const {
+    auto i = std::to_underlying(nid);
+    if (i >= num_rows()) {
+      return 0;
+    }
+    return m_offsets[i + 1] - m_offsets[i];
+  }
+
+  std::span<const node_locator> neighbors(local_node_idx_type nid) const {
+    auto i = std::to_underlying(nid);
+    if (i >= num_rows()) {
+      return {};
+    }
+    return m_nbrs.subspan(m_offsets[i], m_offsets[i + 1] - m_offsets[i]);
+  }
+
+  std::span<const edge_locator> edges(local_node_idx_type nid) const {
+    auto i = std::to_underlying(nid);
+    if (i >= num_rows()) {
+      return {};
+    }
+    return m_edges.subspan(m_offsets[i], m_offsets[i + 1] - m_offsets[i]);
+  }
+
+ private:
+  std::span<const size_t>       m_offsets;
+  std::span<const node_locator> m_nbrs;
+  std::span<const edge_locator> m_edges;
+};
+
+/**
+ * @brief CSR adjacency over rank-local nodes.  Instantiated with the Metall
+ * allocator for the persistent index and with std::allocator for adjacencies
+ * of where-filtered subgraphs.
+ *
+ * @tparam Alloc
+ */
+template <typename Alloc>
+class metall_graph::basic_csr {
+ private:
+  template <typename T>
+  using vector_type = boost::container::vector<
+    T, typename std::allocator_traits<Alloc>::template rebind_alloc<T>>;
+
+ public:
+  /// A single (row, neighbor, edge) triple staged for build()
+  struct entry {
+    local_node_idx_type row;
+    node_locator        nbr;
+    edge_locator        edge;
+
+    auto operator<=>(const entry&) const = default;
+  };
+
+  explicit basic_csr(const Alloc& alloc = Alloc())
+      : m_offsets(alloc), m_nbrs(alloc), m_edges(alloc) {}
+
+  bool valid() const { return m_valid; }
+
+  /// Marks the index stale; storage is released on the next build()
+  void invalidate() { m_valid = false; }
+
+  void clear() {
+    m_offsets.clear();
+    m_offsets.shrink_to_fit();
+    m_nbrs.clear();
+    m_nbrs.shrink_to_fit();
+    m_edges.clear();
+    m_edges.shrink_to_fit();
+    m_valid = false;
+  }
+
+  /**
+   * @brief Builds the CSR from staged entries.  Entries are consumed (sorted
+   * in place).
+   *
+   * @param num_rows Number of local node rows
+   * @param entries Staged entries, entry.row must be < num_rows
+   */
+  void build(size_t num_rows, std::vector<entry>& entries) {
+    clear();
+    std::sort(entries.begin(), entries.end());
+
+    m_offsets.resize(num_rows + 1, 0);
+    for (const auto& e : entries) {
+      ++m_offsets[std::to_underlying(e.row) + 1];
+    }
+    for (size_t i = 0; i < num_rows; ++i) {
+      m_offsets[i + 1] += m_offsets[i];
+    }
+
+    m_nbrs.reserve(entries.size());
+    m_edges.reserve(entries.size());
+    for (const auto& e : entries) {
+      m_nbrs.push_back(e.nbr);
+      m_edges.push_back(e.edge);
+    }
+    m_valid = true;
+  }
+
+  /**
+   * @brief Adds staged entries to the CSR and grows it to num_rows rows.
+   * Rows stay sorted.  Entries are consumed (sorted in place).
+   *
+   * @param num_rows Number of local node rows, at least the current number
+   * @param entries Staged entries, entry.row must be < num_rows
+   */
+  void merge(size_t num_rows, std::vector<entry>& entries) {
+    std::sort(entries.begin(), entries.end());
+
+    const size_t old_rows = m_offsets.empty() ? 0 : m_offsets.size() - 1;
+    vector_type<size_t>       offsets(m_offsets.get_allocator());
+    vector_type<node_locator> nbrs(m_nbrs.get_allocator());
+    vector_type<edge_locator> edges(m_edges.get_allocator());
+    offsets.reserve(num_rows + 1);
+    nbrs.reserve(m_nbrs.size() + entries.size());
+    edges.reserve(m_edges.size() + entries.size());
+
+    offsets.push_back(0);
+    auto it = entries.begin();
+    for (size_t r = 0; r < num_rows; ++r) {
+      size_t j = r < old_rows ? m_offsets[r] : 0;
+      size_t last = r < old_rows ? m_offsets[r + 1] : 0;
+      for (; it != entries.end() && std::to_underlying(it->row) == r; ++it) {
+        for (; j < last && std::make_pair(m_nbrs[j], m_edges[j]) <
+                             std::make_pair(it->nbr, it->edge);
+             ++j) {
+          nbrs.push_back(m_nbrs[j]);
+          edges.push_back(m_edges[j]);
+        }
+        nbrs.push_back(it->nbr);
+        edges.push_back(it->edge);
+      }
+      for (; j < last; ++j) {
+        nbrs.push_back(m_nbrs[j]);
+        edges.push_back(m_edges[j]);
+      }
+      offsets.push_back(nbrs.size());
+    }
+
+    m_offsets.swap(offsets);
+    m_nbrs.swap(nbrs);
+    m_edges.swap(edges);
+  }
+
+  csr_view view() const {
+    return csr_view({std::to_address(m_offsets.data()), m_offsets.size()},
+                    {std::to_address(m_nbrs.data()), m_nbrs.size()},
+                    {std::to_address(m_edges.data()), m_edges.size()});
+  }
+
+ private:
+  vector_type<size_t>       m_offsets;
+  vector_type<node_locator> m_nbrs;
+  vector_type<edge_locator> m_edges;
+  bool                      m_valid{false};
+};
+
+}  // namespace metalldata
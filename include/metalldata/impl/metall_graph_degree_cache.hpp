@@ -0,0 +1,55 @@
+// Copyright Lawrence Livermore National Security, LLC and other MetallData
+// Project Developers. See the top-level COPYRIGHT file for details.
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+#include <metalldata/metall_graph.hpp>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <boost/container/vector.hpp>
+
+namespace metalldata {
+
+/**
+ * @brief Persistent in/out degrees of the whole graph over rank-local nodes,
+ * indexed by local_node_idx_type.  Filled from the adjacency on first use and
+ * marked stale together with it.
+ *
+ */
+class metall_graph::degree_cache {
+ private:
+  using allocator_type = metall::manager::allocator_type<std::byte>;
+
+  template <typename T>
+  using vector_type = boost::container::vector<
+    T, typename std::allocator_traits<allocator_type>::template rebind_alloc<
+         T>>;
+
+ public:
+  explicit degree_cache(const allocator_type& alloc)
+      : m_in_degree(alloc), m_out_degree(alloc) {}
+
+  bool valid() const { return m_valid; }
+
+  /// Marks the cache stale; storage is reused by the next assign()
+  void invalidate() { m_valid = false; }
+
+  void assign(const std::vector<int64_t>& in_degree,
+              const std::vector<int64_t>& out_degree) {
+    m_in_degree.assign(in_degree.begin(), in_degree.end());
+    m_out_degree.assign(out_degree.begin(), out_degree.end());
+    m_valid = true;
+  }
+
+  const vector_type<int64_t>& in_degree() const { return m_in_degree; }
+  const vector_type<int64_t>& out_degree() const { return m_out_degree; }
+
+ private:
+  vector_type<int64_t> m_in_degree;
+  vector_type<int64_t> m_out_degree;
+  bool                 m_valid{false};
+};
+
+}  // namespace metalldata
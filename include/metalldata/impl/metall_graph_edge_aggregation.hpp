@@ -0,0 +1,25 @@
+// Copyright Lawrence Livermore National Security, LLC and other MetallData
+// Project Developers. See the top-level COPYRIGHT file for details.
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+#include <metalldata/metall_graph.hpp>
+#include <string>
+
+namespace metalldata {
+
+/**
+ * @brief One aggregation of collapse_edges(): out = op(in) over every group of
+ * parallel edges.  op is one of "count", "sum", "min", "max" or "first"; count
+ * ignores in.  sum, min and max take int64_t or double series; first takes any
+ * type and keeps the value of the edge that survives.
+ *
+ */
+struct metall_graph::edge_aggregation {
+  series_name out;
+  std::string op;
+  series_name in;
+};
+
+}  // namespace metalldata
@@ -0,0 +1,97 @@
+// Copyright Lawrence Livermore National Security, LLC and other MetallData
+// Project Developers. See the top-level COPYRIGHT file for details.
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+#include <metalldata/metall_graph.hpp>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <boost/container/vector.hpp>
+
+namespace metalldata {
+
+/**
+ * @brief Persistent state behind enable_maintained_analytics(): a union-find
+ * parent forest and in/out degree counters over rank-local nodes, indexed by
+ * local_node_idx_type.  Between updates the forest is flattened, i.e., every
+ * node points at the smallest node locator of its component.
+ *
+ */
+class metall_graph::maintained_analytics {
+ private:
+  using allocator_type = metall::manager::allocator_type<std::byte>;
+
+  template <typename T>
+  using vector_type = boost::container::vector<
+    T, typename std::allocator_traits<allocator_type>::template rebind_alloc<
+         T>>;
+
+ public:
+  explicit maintained_analytics(const allocator_type& alloc)
+      : m_parent(alloc), m_in_degree(alloc), m_out_degree(alloc) {}
+
+  bool enabled() const { return m_enabled; }
+
+  /// False if edges were removed since the last update; deletions cannot be
+  /// folded into a union-find, so the next update rebuilds from scratch.
+  bool valid() const { return m_valid; }
+
+  void invalidate() { m_valid = false; }
+
+  void enable() {
+    m_enabled = true;
+    m_valid = false;
+  }
+
+  void disable() {
+    clear();
+    m_enabled = false;
+  }
+
+  void clear() {
+    m_parent.clear();
+    m_parent.shrink_to_fit();
+    m_in_degree.clear();
+    m_in_degree.shrink_to_fit();
+    m_out_degree.clear();
+    m_out_degree.shrink_to_fit();
+    m_valid = false;
+  }
+
+  void set_valid() { m_valid = true; }
+
+  /**
+   * @brief Grows the state to num_slots nodes.  New nodes are singleton
+   * components with zero degree.
+   *
+   * @param rank This rank, used to build the new nodes' locators
+   * @param num_slots Number of local node slots
+   */
+  void resize(int rank, size_t num_slots) {
+    for (size_t i = m_parent.size(); i < num_slots; ++i) {
+      m_parent.push_back(make_node_locator(rank, local_node_idx_type{i}));
+    }
+    m_in_degree.resize(num_slots, 0);
+    m_out_degree.resize(num_slots, 0);
+  }
+
+  size_t size() const { return m_parent.size(); }
+
+  vector_type<node_locator>&       parent() { return m_parent; }
+  const vector_type<node_locator>& parent() const { return m_parent; }
+  vector_type<int64_t>&            in_degree() { return m_in_degree; }
+  const vector_type<int64_t>&      in_degree() const { return m_in_degree; }
+  vector_type<int64_t>&            out_degree() { return m_out_degree; }
+  const vector_type<int64_t>&      out_degree() const { return m_out_degree; }
+
+ private:
+  vector_type<node_locator> m_parent;
+  vector_type<int64_t>      m_in_degree;
+  vector_type<int64_t>      m_out_degree;
+  bool                      m_enabled{false};
+  bool                      m_valid{false};
+};
+
+}  // namespace metalldata
@@ -55,9 +55,13 @@ struct metall_graph::series_name {
 
   bool is_reserved() const {
     return *this == U_COL || *this == V_COL || *this == DIR_COL ||
-           *this == NODE_COL;
+           *this == NODE_COL || is_internal();
   }
 
+  // Internal series are reserved and also hidden from selectors and series
+  // listings.
+  bool is_internal() const { return *this == U_LOC_COL || *this == V_LOC_COL; }
+
   // TODO:  Delete these after updating reference locations.  These are "full
   // qualified" series names.
   static const series_name U_COL;
@@ -65,6 +69,10 @@ struct metall_graph::series_name {
   static const series_name DIR_COL;
   static const series_name NODE_COL;
 
+  // Node locators of the edge endpoints, stored as int64_t.
+  static const series_name U_LOC_COL;
+  static const series_name V_LOC_COL;
+
  private:
   std::string m_prefix;
   std::string m_unqualified;
@@ -81,6 +89,10 @@ inline const metall_graph::series_name metall_graph::series_name::DIR_COL{
   "edge.directed"};
 inline const metall_graph::series_name metall_graph::series_name::NODE_COL{
   "node.id"};
+inline const metall_graph::series_name metall_graph::series_name::U_LOC_COL{
+  "edge.u_locator"};
+inline const metall_graph::series_name metall_graph::series_name::V_LOC_COL{
+  "edge.v_locator"};
 
 }  // namespace metalldata
 
@@ -12,8 +12,10 @@
 #include <utility>
 #include <variant>
 #include <map>
+#include <set>
 #include <string>
 #include <string_view>
+#include <tuple>
 #include <vector>
 #include <metall/metall.hpp>
 #include <multiseries/multiseries_record.hpp>
@@ -44,7 +46,8 @@ Everything is a multigraph
 
 internally hardcode u,v has primary col names in edge tables
 
-Edges are not partitioned by u/v hashing
+Edges are not partitioned by u/v hashing, unless repartition_edges() was
+called
 
 Vertex ids are always string,  col name in vertex dataframe is 'id'.
 Vertices are partitioned by has of id
@@ -71,6 +74,20 @@ class metall_graph {
   enum class node_series_idx_type : std::size_t;
   enum class edge_series_idx_type : std::size_t;
 
+  // Forward declared, see: impl/metall_graph_csr.hpp
+  class csr_view;
+  template <typename Alloc>
+  class basic_csr;
+  using csr_type = basic_csr<std::allocator<std::byte>>;
+  using persistent_csr_type =
+    basic_csr<metall::manager::allocator_type<std::byte>>;
+
+  // Forward declared, see impl/metall_graph_maintained.hpp
+  class maintained_analytics;
+
+  // Forward declared, see impl/metall_graph_degree_cache.hpp
+  class degree_cache;
+
  public:
   using data_types =
     std::variant<std::monostate, bool, int64_t, double, std::string>;
@@ -84,6 +101,9 @@ class metall_graph {
   /// Forward declared, see impl/metall_graph_where.hpp
   struct where_clause;
 
+  /// Forward declared, see impl/metall_graph_edge_aggregation.hpp
+  struct edge_aggregation;
+
   metall_graph(ygm::comm& comm, std::string_view path, bool overwrite = false);
 
   ~metall_graph();
@@ -100,6 +120,17 @@ class metall_graph {
     std::string_view path, bool recursive, std::string_view col_u,
     std::string_view col_v, bool directed);
 
+  /**
+   * @brief Moves every edge record to the owner of its u ("source") or v
+   * ("target") endpoint, so that the edges of a node's adjacency row are
+   * local to it.  Edge locators change.  Collective.
+   *
+   * @param policy "source" or "target"
+   * @return Number of edges moved, as num_edges_moved
+   */
+  result<std::map<std::string, size_t>> repartition_edges(
+    std::string_view policy);
+
   result<std::map<std::string, std::any>> dump_parquet_verts(
     std::string_view path, const std::vector<series_name>& meta,
     bool overwrite);
@@ -108,11 +139,73 @@ class metall_graph {
     std::string_view path, const std::vector<series_name>& meta,
     bool overwrite);
 
+  /**
+   * @brief Copies the subgraph selected by where into a new graph at
+   * dest_path: the selected nodes, the edges between them (or the selected
+   * edges and their endpoints, for an edge where clause), and the given node
+   * and edge series.  dest_path must not exist.  Collective.
+   *
+   * @param where Where clause
+   * @param dest_path Storage path of the new graph
+   * @param series Node and edge series to copy, besides the reserved ones
+   * @return Number of nodes and edges copied
+   */
+  result<std::map<std::string, size_t>> extract_subgraph(
+    const where_clause& where, std::string_view dest_path,
+    const std::vector<series_name>& series);
+
+  /**
+   * @brief Generates num_walks random walks of up to walk_len nodes from every
+   * node selected by where, and writes them to <out_path>_<rank>.parquet with
+   * columns walk_id, step and node.  Walks follow the forward adjacency and
+   * stop early at nodes without out-neighbors.  With p == q == 1 the walks are
+   * uniform (DeepWalk); otherwise steps are biased as in node2vec, by 1/p to
+   * return and 1/q to move away.  Collective.
+   *
+   * @param num_walks Walks per start node
+   * @param walk_len Maximum number of nodes per walk
+   * @param p node2vec return parameter
+   * @param q node2vec in-out parameter
+   * @param optseed Random seed
+   * @param where Where clause
+   * @param out_path Output path prefix
+   * @param overwrite Overwrite existing files
+   * @return Rows written and filename of this rank
+   */
+  result<std::map<std::string, std::any>> random_walks(
+    size_t num_walks, size_t walk_len, double p, double q,
+    std::optional<uint64_t> optseed, const where_clause& where,
+    std::string_view out_path, bool overwrite);
+
+  /**
+   * @brief Merges parallel edges, i.e., edges with the same (u, v, directed)
+   * (undirected edges match in either orientation), selected by where into a
+   * single edge per group.  Per group, the edge with the smallest locator
+   * survives and the aggregations are written to it.  Collective.
+   *
+   * @param aggs Aggregations to compute
+   * @param where Where clause
+   * @return Number of groups and of edges removed
+   */
+  result<std::map<std::string, size_t>> collapse_edges(
+    const std::vector<edge_aggregation>& aggs, const where_clause& where);
+
   result<> erase_edges(const where_clause& where);
 
   result<> erase_edges(const series_name&                     name,
                        boost::unordered_flat_set<std::string> haystack);
 
+  /**
+   * @brief Renumbers the local edge (and node) ids so that removed records
+   * leave no holes, and releases their series storage.  Node locators held in
+   * m_pnode_to_locator and in the edge locator series are remapped, and edges
+   * of removed nodes are removed.  Edge locators change.  Collective.
+   *
+   * @return Approximate bytes released, as bytes_reclaimed, and the number of
+   * removed edge and node slots dropped
+   */
+  result<std::map<std::string, size_t>> compact();
+
   template <typename Fn, typename T>  // defined in metall_graph_faker.hpp
   result<> add_faker_series(const metall_graph::series_name& name,
                             Fn faker_func, const where_clause& where);
@@ -192,6 +285,43 @@ class metall_graph {
   result<> degrees(series_name in_name, series_name out_name,
                    const where_clause& where);
 
+  /**
+   * @brief Reduces an edge series onto the endpoints of the edges selected by
+   * where.  direction "out" reduces onto u, "in" onto v and "both" onto both;
+   * undirected edges always reach both endpoints.  Edges without a value are
+   * skipped.  Collective.
+   *
+   * @param edge_series Input edge series, int64_t or double unless agg is
+   * count
+   * @param agg One of sum, mean, min, max, count.  sum, min and max keep the
+   * input type, mean is double, count is int64_t.
+   * @param direction One of out, in, both
+   * @param out_node_series Output node series.  Nodes with no values are left
+   * empty, except for count, which writes 0.
+   * @param where Where clause
+   * @return result<>
+   */
+  result<> aggregate_to_nodes(const series_name& edge_series,
+                              std::string_view agg, std::string_view direction,
+                              const series_name&  out_node_series,
+                              const where_clause& where);
+
+  /**
+   * @brief Copies a node series onto the edges selected by where, from the
+   * edge's u or v endpoint.  The copy is not kept in sync with later changes
+   * of the node series.  Collective.
+   *
+   * @param node_series Input node series
+   * @param endpoint "u" or "v"
+   * @param out_edge_series Output edge series, of the type of node_series
+   * @param where Where clause
+   * @return result<>
+   */
+  result<> join_node_series_to_edges(const series_name& node_series,
+                                     std::string_view   endpoint,
+                                     const series_name& out_edge_series,
+                                     const where_clause& where);
+
   result<> degrees2(series_name in_name, series_name out_name,
                     const where_clause& where);
 
@@ -202,6 +332,163 @@ class metall_graph {
   result<> connected_components(const series_name&  out_node_series,
                                 const where_clause& where);
 
+  /**
+   * @brief Computes weighted shortest path distances from the sources by
+   * delta-stepping.  Directed edges are followed one way only; undirected
+   * edges both ways.  Edges without a weight are skipped with a warning;
+   * negative weights are an error.  Unreached nodes are left empty.
+   * Collective.
+   *
+   * @param out_node_series Output node series (double)
+   * @param weight_series Edge weight series (double or int64_t)
+   * @param sources Source node ids
+   * @param max_dist Distances beyond max_dist are not explored
+   * @param where Where clause
+   * @return result<>
+   */
+  result<> sssp(const series_name& out_node_series,
+                const series_name& weight_series,
+                const std::vector<std::string>& sources, double max_dist,
+                const where_clause& where);
+
+  /**
+   * @brief Computes strongly connected components of the subgraph selected by
+   * where.  Directed edges are followed one way only; undirected edges both
+   * ways.  Each component is labeled with the id of one of its nodes.
+   * Collective.
+   *
+   * @param out_node_series Output node series (string)
+   * @param where Where clause
+   * @return result<>
+   */
+  result<> strongly_connected_components(const series_name&  out_node_series,
+                                         const where_clause& where);
+
+  /**
+   * @brief Computes PageRank over the subgraph selected by where.  Dangling
+   * nodes spread their rank uniformly.  Collective.
+   *
+   * @param out_node_series Output node series (double)
+   * @param damping Damping factor, in [0, 1)
+   * @param tol Stop once the L1 change of an iteration falls below tol
+   * @param max_iter Maximum number of iterations
+   * @param where Where clause
+   * @return result<>
+   */
+  result<> pagerank(const series_name& out_node_series, double damping,
+                    double tol, size_t max_iter, const where_clause& where);
+
+  /**
+   * @brief Computes personalized PageRank: teleports and dangling rank return
+   * to the sources only.  Collective.
+   */
+  result<> personalized_pagerank(const series_name& out_node_series,
+                                 const std::vector<std::string>& sources,
+                                 double damping, double tol, size_t max_iter,
+                                 const where_clause& where);
+
+  /**
+   * @brief Counts, for each node, the triangles it belongs to in the
+   * subgraph selected by where, ignoring edge direction, self loops and
+   * parallel edges.  Collective.
+   *
+   * @param out_node_series Output node series (int64_t)
+   * @param where Where clause
+   * @return result<>
+   */
+  result<> triangle_count(const series_name&  out_node_series,
+                          const where_clause& where);
+
+  /**
+   * @brief Computes the local clustering coefficient, 2T / (d (d - 1)) over
+   * the same undirected simple graph as triangle_count().  Nodes with degree
+   * below 2 get 0.  Collective.
+   *
+   * @param out_node_series Output node series (double)
+   * @param where Where clause
+   * @return result<>
+   */
+  result<> clustering_coefficient(const series_name&  out_node_series,
+                                  const where_clause& where);
+
+  /**
+   * @brief Computes the core number of each node over the undirected simple
+   * graph selected by where, by distributed h-index iteration.  Collective.
+   *
+   * @param out_node_series Output node series (int64_t)
+   * @param where Where clause
+   * @return result<>
+   */
+  result<> kcore(const series_name& out_node_series, const where_clause& where);
+
+  /**
+   * @brief Link-prediction scores of node pairs over the undirected simple
+   * graph selected by where: common neighbors, Jaccard |N(u) & N(v)| /
+   * |N(u) | N(v)|, and Adamic-Adar, the sum of 1 / log(deg(w)) over common
+   * neighbors w.  Collective.
+   *
+   * @param pairs (u, v) node labels, the same on every rank.  If absent, all
+   * distinct non-adjacent pairs at distance two are scored.
+   * @param where Where clause
+   * @return Rows of u, v, common neighbors (int64_t), Jaccard (double) and
+   * Adamic-Adar (double)
+   */
+  result<ygm::container::bag<std::vector<data_types>>> pair_similarity(
+    const std::optional<std::vector<std::pair<std::string, std::string>>>&
+                        pairs,
+    const where_clause& where);
+
+  /**
+   * @brief Writes the scores of pair_similarity() for the endpoints of every
+   * edge selected by where to new edge series.  Outputs that are not given
+   * are skipped.  Collective.
+   *
+   * @param out_common Output edge series for common neighbors (int64_t)
+   * @param out_jaccard Output edge series for Jaccard (double)
+   * @param out_adamic_adar Output edge series for Adamic-Adar (double)
+   * @param where Where clause
+   * @return result<>
+   */
+  result<> edge_similarity(const std::optional<series_name>& out_common,
+                           const std::optional<series_name>& out_jaccard,
+                           const std::optional<series_name>& out_adamic_adar,
+                           const where_clause&               where);
+
+  /**
+   * @brief Assigns community labels by semi-synchronous label propagation over
+   * the undirected simple graph selected by where.  Each node adopts the most
+   * frequent label among its neighbors (keeping its own on ties it is part
+   * of, else the smallest).  In each iteration only nodes whose hashed
+   * priority beats all of their neighbors' update, so adjacent nodes never
+   * update together and labels cannot swap back and forth.  Collective.
+   *
+   * @param out_node_series Output node series (int64_t)
+   * @param max_iters Maximum number of iterations
+   * @param where Where clause
+   * @return Iterations run, as num_iterations, and whether the labels became
+   * stable before max_iters, as converged (0 or 1)
+   */
+  result<std::map<std::string, size_t>> label_propagation(
+    const series_name& out_node_series, size_t max_iters,
+    const where_clause& where);
+
+  /**
+   * @brief Enables maintained analytics.  Connected component labels and
+   * in/out degrees are kept in a persistent union-find and degree counters,
+   * updated by every ingest_parquet_edges call, and written to the series
+   * node.maintained_cc, node.maintained_in_degree and
+   * node.maintained_out_degree.  Builds the initial state from the current
+   * graph.  Collective.
+   *
+   * @return result<>
+   */
+  result<> enable_maintained_analytics();
+
+  /// Stops maintaining the analytics; existing maintained series are kept.
+  void disable_maintained_analytics();
+
+  bool maintained_analytics_enabled() const;
+
   // TODO: also allow val a function
   result<> assign(series_name series_name, const series_types& val,
                   const where_clause& where);
@@ -245,12 +532,22 @@ class metall_graph {
   map_node_to_locator_type* m_pnode_to_locator = nullptr;
   /// String store
   string_store_type* m_pstring_store = nullptr;
+  /// Persistent forward adjacency index, see priv_adjacency()
+  persistent_csr_type* m_padjacency = nullptr;
+  /// Persistent reverse adjacency index, see priv_reverse_adjacency()
+  persistent_csr_type* m_preverse_adjacency = nullptr;
+  /// Persistent state of enable_maintained_analytics()
+  maintained_analytics* m_pmaintained = nullptr;
+  /// Persistent unfiltered degrees, see priv_degrees()
+  degree_cache* m_pdegrees = nullptr;
   /// YGM pointer to self, used for async callbacks. Initialized in constructor.
   typename ygm::ygm_ptr<metall_graph> pthis = nullptr;
 
   edge_series_idx_type m_u_col_idx;
   edge_series_idx_type m_v_col_idx;
   edge_series_idx_type m_dir_col_idx;
+  edge_series_idx_type m_u_loc_col_idx;
+  edge_series_idx_type m_v_loc_col_idx;
   node_series_idx_type m_node_col_idx;
 
   /**
@@ -263,14 +560,28 @@ class metall_graph {
     local_edge_idx_type eid) const;
 
   /**
-   * @brief Returns an edge's endpoints (u,v) as node_locators
+   * @brief Returns an edge's endpoints (u,v) as node_locators.  Every live
+   * edge has both, since priv_fill_edge_locators() removes edges whose
+   * endpoints cannot be resolved.
    *
    * @param eid Edge ID
-   * @return std::optional<std::pair<node_locator, node_locator>>
+   * @return std::pair<node_locator, node_locator>
    */
   std::pair<node_locator, node_locator> pl_get_edge_uv_locators(
     local_edge_idx_type eid) const;
 
+  /**
+   * @brief Resolves the endpoint labels of edges [first_eid, slot count) and
+   * stores their node locators in the U_LOC_COL / V_LOC_COL series.  Edges
+   * whose endpoints cannot be resolved are removed.  Rank local; every
+   * endpoint must already be in m_pnode_to_locator.
+   *
+   * @param first_eid First edge ID to fill
+   * @return Number of edges removed because their endpoints could not be
+   * resolved
+   */
+  size_t priv_fill_edge_locators(local_edge_idx_type first_eid);
+
   /**
    * @brief Returns an edge's directed field
    *
@@ -392,10 +703,24 @@ class metall_graph {
 
   size_t pl_num_nodes() const { return m_pnodes->num_records(); };
   size_t pl_num_edges() const { return m_pedges->num_records(); };
+  /// Number of local node slots, i.e., one past the largest local_node_idx
+  size_t pl_num_node_slots() const { return m_pnodes->num_record_slots(); };
 
   result<> priv_in_out_degree(series_name name, const where_clause& where,
                               bool outdeg);
 
+  std::pair<std::vector<int64_t>, std::vector<int64_t>> priv_degree_counts(
+    csr_view adj);
+
+  /**
+   * @brief In- and out-degrees of the subgraph selected by where, indexed by
+   * local_node_idx_type.  Unfiltered degrees are served from the persistent
+   * degree cache, which is filled on first use and invalidated together with
+   * the adjacency.  Collective.
+   */
+  std::pair<std::vector<int64_t>, std::vector<int64_t>> priv_degrees(
+    const where_clause& where);
+
   template <typename Fn>
   void priv_for_all_edges(Fn func) const;
 
@@ -467,6 +792,14 @@ class metall_graph {
    */
   std::optional<node_locator> pl_get_node_locator(std::string_view label) const;
 
+  /**
+   * @brief Records the locator of a node label in this rank's reverse index.
+   *
+   * @param label String node label
+   * @param nl Locator of the node, which may be remote
+   */
+  void priv_index_node_locator(std::string_view label, node_locator nl);
+
   /**
    * @brief Checks the integrity of the indexes
    *
@@ -506,6 +839,175 @@ class metall_graph {
   // Forward declared, see: impl/metall_graph_node_locator_set.hpp
   class node_locator_set;
 
+  /**
+   * @brief Returns the forward adjacency (u->v, plus v->u for undirected
+   * edges) of the subgraph selected by where, partitioned by node owner.
+   * Collective.
+   *
+   * The unfiltered adjacency is persisted in the Metall store, built on first
+   * use and reused until the edge set changes.  Filtered adjacencies are built
+   * into scratch, which must outlive the returned view.
+   *
+   * @param where Where clause
+   * @param scratch Storage for a filtered adjacency
+   * @return csr_view
+   */
+  csr_view priv_adjacency(const where_clause& where, csr_type& scratch);
+
+  /**
+   * @brief Builds the forward adjacency of the subgraph selected by where.
+   * Collective.
+   */
+  template <typename Csr>
+  void priv_build_adjacency(const where_clause& where, Csr& csr) const;
+
+  /**
+   * @brief Marks the persistent adjacency and degree cache stale.  Must be
+   * called by anything that adds or removes edges.
+   */
+  void priv_invalidate_adjacency();
+
+  /**
+   * @brief Builds the reverse (in-neighbor) adjacency of adj into scratch.
+   * Row v lists every u with v in adj.neighbors(u).  Collective.
+   *
+   * @param adj Forward adjacency
+   * @param scratch Storage for the reverse adjacency
+   * @return csr_view
+   */
+  csr_view priv_reverse_adjacency(csr_view adj, csr_type& scratch) const;
+
+  /**
+   * @brief Returns the reverse adjacency of adj, the forward adjacency of the
+   * subgraph selected by where.  Row v lists every u with v in
+   * adj.neighbors(u), together with the edge locators.  Collective.
+   *
+   * The unfiltered reverse adjacency is persisted in the Metall store next to
+   * the forward one, owned by the owner of v.  It is built on first use and
+   * extended in place by ingests.
+   *
+   * @param where Where clause that selected adj
+   * @param adj Forward adjacency
+   * @param scratch Storage for a filtered reverse adjacency
+   * @return csr_view
+   */
+  csr_view priv_reverse_adjacency(const where_clause& where, csr_view adj,
+                                  csr_type& scratch);
+
+  /**
+   * @brief Builds the reverse adjacency of adj.  Collective.
+   */
+  template <typename Csr>
+  void priv_build_reverse_adjacency(csr_view adj, Csr& csr) const;
+
+  /**
+   * @brief Adds the edges from first_eid onwards to the persistent forward
+   * and reverse adjacencies that are built, without a full rebuild.  Marks
+   * the degree cache stale.  Collective.
+   */
+  void priv_extend_adjacency(local_edge_idx_type first_eid);
+
+  /**
+   * @brief Compacts the node records and rewrites every node locator this
+   * rank holds, in m_pnode_to_locator and the edge locator series, to the
+   * new local ids.  Locators of removed nodes are dropped.  Collective.
+   */
+  void priv_compact_nodes();
+
+  /**
+   * @brief Builds the undirected simple adjacency of the subgraph selected by
+   * where: edges in both directions, without self loops or parallel edges.
+   * Rows are sorted and carry no edge locators.  Collective.
+   *
+   * @param where Where clause
+   * @param out Storage for the adjacency
+   */
+  void priv_undirected_adjacency(const where_clause& where, csr_type& out);
+
+  /**
+   * @brief Direction-optimizing multi-source BFS over adj.  Runs top-down
+   * while the frontier is small and switches to bottom-up over the reverse
+   * adjacency when frontier edges dominate the unvisited edges.  A bottom-up
+   * step fetches frontier membership only for the remote in-neighbors of
+   * this rank's unvisited nodes.  Collective.
+   *
+   * @param adj Forward adjacency
+   * @param sources Local source nodes on this rank (may be empty)
+   * @param max_level Maximum number of levels to expand
+   * @param where Where clause that selected adj, for the reverse adjacency
+   * @return Distance of each local node slot, -1 if unreached
+   */
+  std::vector<int64_t> priv_bfs(csr_view                                adj,
+                                const std::vector<local_node_idx_type>& sources,
+                                size_t max_level, const where_clause& where);
+
+  /**
+   * @brief Distributed FastSV over a parent forest.  parent is indexed by
+   * local node id; edges must be stored at both endpoints.  On return every
+   * node points at the smallest node locator of its component.  Collective.
+   *
+   * @param parent Parent forest, initially any forest whose trees lie within
+   * components
+   * @param edges (local node, neighbor) pairs
+   */
+  void priv_fastsv(
+    std::vector<node_locator>&                                      parent,
+    const std::vector<std::pair<local_node_idx_type, node_locator>>& edges);
+
+  /**
+   * @brief Looks up the node labels of locators, which may be remote.
+   * Collective.
+   */
+  std::map<node_locator, std::string> priv_gather_node_labels(
+    const std::set<node_locator>& locators);
+
+  /**
+   * @brief If maintained analytics are enabled, folds the edges from
+   * first_eid onwards into them and rewrites the maintained series.  Rebuilds
+   * from all edges if the state was invalidated.  Collective.
+   */
+  result<> priv_refresh_maintained(local_edge_idx_type first_eid);
+
+  /**
+   * @brief Folds the edges from first_eid onwards into the maintained state.
+   * Collective.
+   *
+   * @return The local nodes whose component or degrees changed, or
+   * std::nullopt if the state was rebuilt from scratch
+   */
+  std::optional<std::vector<local_node_idx_type>> priv_update_maintained(
+    local_edge_idx_type first_eid);
+
+  result<> priv_write_maintained_series(
+    const std::optional<std::vector<local_node_idx_type>>& changed);
+
+  /**
+   * @brief Per-node triangle counts and undirected simple degrees, indexed by
+   * local node id.  Collective.
+   */
+  std::pair<std::vector<int64_t>, std::vector<int64_t>> priv_triangle_counts(
+    const where_clause& where);
+
+  /// Candidate pair (u, v, tag), held at the owner of u
+  using similarity_candidate =
+    std::tuple<local_node_idx_type, node_locator, edge_locator>;
+
+  /// Scores of a candidate: (label of u, v, tag, common, Jaccard, Adamic-Adar)
+  using similarity_row = std::tuple<std::string, local_node_idx_type,
+                                    edge_locator, int64_t, double, double>;
+
+  /**
+   * @brief Scores candidate pairs over the undirected simple adjacency und.
+   * Rows are returned at the owner of v.  Collective.
+   */
+  std::vector<similarity_row> priv_pair_similarity(
+    csr_view und, const std::vector<similarity_candidate>& candidates);
+
+  result<> priv_pagerank(const series_name&              out_name,
+                         const std::vector<std::string>& sources,
+                         double damping, double tol, size_t max_iter,
+                         const where_clause& where);
+
   /// Forward declared friend for testing internal state
   friend class metall_graph_test;
 
@@ -531,8 +1033,12 @@ struct std::hash<metalldata::metall_graph::series_types> {
 };
 
 #include <metalldata/impl/metall_graph_node_locator_set.hpp>
+#include <metalldata/impl/metall_graph_csr.hpp>
+#include <metalldata/impl/metall_graph_maintained.hpp>
+#include <metalldata/impl/metall_graph_degree_cache.hpp>
 #include <metalldata/impl/metall_graph_series_name.hpp>
 #include <metalldata/impl/metall_graph_where.hpp>
+#include <metalldata/impl/metall_graph_edge_aggregation.hpp>
 #include <metalldata/impl/metall_graph_faker.ipp>
 #include <metalldata/impl/metall_graph_priv_for_all.ipp>
 #include <metalldata/impl/metall_graph_set_column.ipp>
@@ -6,10 +6,14 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
 #include <cstdlib>
 #include <deque>
 #include <memory>
 #include <scoped_allocator>
+#include <span>
 #include <stdexcept>
 #include <string>
 #include <string_view>
@@ -53,10 +57,17 @@ class series_container {
 
   using pointer_type = typename std::allocator_traits<Alloc>::pointer;
 
-  struct value_with_flag {
-    bool       empty{true};
-    value_type value;
-  };
+  // Dense bool values are packed 64 per word, like the validity bits.
+  static constexpr bool   k_packed_bool = std::is_same_v<value_type, bool>;
+  static constexpr size_t k_word_bits   = 64;
+  // Upper bound of the slots handed to one for_each_chunk() call
+  static constexpr size_t k_chunk_slots = 4096;
+  using dense_value_type =
+      std::conditional_t<k_packed_bool, uint64_t, value_type>;
+
+  // at() cannot hand out a reference to a packed bit
+  using const_reference =
+      std::conditional_t<k_packed_bool, value_type, const value_type &>;
 
   //  template <typename T>
   //  using vector_type = bc::vector<T, scp_allocator<T>>;
@@ -75,11 +86,14 @@ class series_container {
  public:
 
   explicit series_container(const allocator_type &alloc = allocator_type())
-      : m_map_container(alloc), m_deq_container(alloc) {}
+      : m_map_container(alloc), m_validity(alloc), m_deq_values(alloc) {}
 
   explicit series_container(const container_kind &kind,
                             const allocator_type &alloc = allocator_type())
-      : m_kind(kind), m_map_container(alloc), m_deq_container(alloc) {}
+      : m_kind(kind),
+        m_map_container(alloc),
+        m_validity(alloc),
+        m_deq_values(alloc) {}
 
   // Copy constructor
   series_container(const series_container &other) = default;
@@ -88,8 +102,10 @@ class series_container {
   series_container(series_container &&other) noexcept
       : m_kind(other.m_kind),
         m_n_items(other.m_n_items),
+        m_dense_size(other.m_dense_size),
         m_map_container(std::move(other.m_map_container)),
-        m_deq_container(std::move(other.m_deq_container)) {
+        m_validity(std::move(other.m_validity)),
+        m_deq_values(std::move(other.m_deq_values)) {
     other.clear();
   }
 
@@ -101,8 +117,10 @@ class series_container {
     if (this != &other) {
       m_kind          = other.m_kind;
       m_n_items       = other.m_n_items;
+      m_dense_size    = other.m_dense_size;
       m_map_container = std::move(other.m_map_container);
-      m_deq_container = std::move(other.m_deq_container);
+      m_validity      = std::move(other.m_validity);
+      m_deq_values    = std::move(other.m_deq_values);
       other.clear();
     }
     return *this;
@@ -115,49 +133,68 @@ class series_container {
   series_container(const series_container &other, const allocator_type &alloc)
       : m_kind(other.m_kind),
         m_n_items(other.m_n_items),
+        m_dense_size(other.m_dense_size),
         m_map_container(other.m_map_container, alloc),
-        m_deq_container(other.m_deq_container, alloc) {}
+        m_validity(other.m_validity, alloc),
+        m_deq_values(other.m_deq_values, alloc) {}
 
   // Move constructor with allocator
   series_container(series_container &&other, const allocator_type &alloc)
       : m_kind(other.m_kind),
         m_n_items(other.m_n_items),
+        m_dense_size(other.m_dense_size),
         m_map_container(std::move(other.m_map_container), alloc),
-        m_deq_container(std::move(other.m_deq_container), alloc) {
+        m_validity(std::move(other.m_validity), alloc),
+        m_deq_values(std::move(other.m_deq_values), alloc) {
     other.clear();
   }
 
   // Access the value associated with 'i'
   // Works like the '[]' operator in map container, i.e., if the key does not
   // exist, it creates a new entry. Thus, the slot is not empty anymore.
-  value_type &operator[](size_t i) {
+  // Not available for bool, whose dense values are bit-packed; use set().
+  value_type &operator[](size_t i)
+    requires(!k_packed_bool)
+  {
     if (m_kind == container_kind::sparse) {
       return m_map_container[i];
     } else if (m_kind == container_kind::dense) {
-      if (i >= m_deq_container.size()) {
-        m_deq_container.resize(i + 1);
-        m_n_items = m_n_items + 1;
-      }
-      m_deq_container[i].empty = false;
-      return m_deq_container[i].value;
+      priv_dense_mark_valid(i);
+      return m_deq_values[i];
     }
     throw std::runtime_error("Unknown container kind");
   }
 
-  const value_type &at(size_t i) const {
+  // Set the value associated with 'i'
+  void set(size_t i, const value_type &value) {
+    if (m_kind == container_kind::sparse) {
+      m_map_container[i] = value;
+    } else if (m_kind == container_kind::dense) {
+      priv_dense_mark_valid(i);
+      priv_dense_store(i, value);
+    } else {
+      throw std::runtime_error("Unknown container kind");
+    }
+  }
+
+  const_reference at(size_t i) const {
     if (m_kind == container_kind::sparse) {
       if (!m_map_container.contains(i)) {
         throw std::out_of_range("Index out of range");
       }
       return m_map_container.at(i);
     } else if (m_kind == container_kind::dense) {
-      if (i >= m_deq_container.size()) {
+      if (i >= m_dense_size) {
         throw std::out_of_range("Index out of range");
       }
-      if (m_deq_container[i].empty) {
+      if (!priv_dense_valid(i)) {
         throw "Does not contain a value at the index";
       }
-      return m_deq_container[i].value;
+      if constexpr (k_packed_bool) {
+        return priv_test_bit(m_deq_values, i);
+      } else {
+        return m_deq_values[i];
+      }
     }
     throw std::runtime_error("Unknown container kind");
   }
@@ -175,7 +212,7 @@ class series_container {
     if (m_kind == container_kind::sparse) {
       return m_map_container.size();
     } else if (m_kind == container_kind::dense) {
-      return m_deq_container.size();
+      return m_dense_size;
     }
     throw std::runtime_error("Unknown container kind");
   }
@@ -187,7 +224,7 @@ class series_container {
     if (m_kind == container_kind::sparse) {
       return 1.0;
     } else if (m_kind == container_kind::dense) {
-      return static_cast<double>(m_n_items) / m_deq_container.size();
+      return static_cast<double>(m_n_items) / m_dense_size;
     }
     throw std::runtime_error("Unknown container kind");
   }
@@ -206,30 +243,32 @@ class series_container {
     if (m_kind == container_kind::sparse) {
       return m_map_container.contains(i);
     } else if (m_kind == container_kind::dense) {
-      if (i >= m_deq_container.size()) {
+      if (i >= m_dense_size) {
         return false;
       }
-      return !m_deq_container[i].empty;
+      return priv_dense_valid(i);
     }
     throw std::runtime_error("Unknown container kind");
   }
 
   void clear() {
     m_map_container.clear();
-    m_deq_container.clear();
-    m_n_items = 0;
+    m_validity.clear();
+    m_deq_values.clear();
+    m_n_items    = 0;
+    m_dense_size = 0;
   }
 
   bool erase(size_t i) {
     if (m_kind == container_kind::sparse) {
       return m_map_container.erase(i) > 0;
     } else if (m_kind == container_kind::dense) {
-      if (i >= m_deq_container.size()) {
+      if (i >= m_dense_size) {
         return false;
       }
-      if (!m_deq_container[i].empty) {
-        m_deq_container[i].value.~value_type();
-        m_deq_container[i].empty = true;
+      if (priv_dense_valid(i)) {
+        m_validity[i / k_word_bits] &= ~priv_bit(i);
+        priv_dense_store(i, value_type{});
         --m_n_items;
         return true;
       }
@@ -240,6 +279,60 @@ class series_container {
 
   container_kind kind() const { return m_kind; }
 
+  /// \brief Returns the bytes held by the stored values and validity bits.
+  /// Hash table and allocator overheads are not included.
+  size_t storage_bytes() const {
+    using map_value_type = std::pair<const size_t, value_type>;
+    return m_map_container.size() * sizeof(map_value_type) +
+           m_validity.size() * sizeof(uint64_t) +
+           m_deq_values.size() * sizeof(dense_value_type);
+  }
+
+  /// \brief Calls fn(values, validity, base) over runs of stored values.
+  /// values is contiguous and holds slots [base, base + values.size());
+  /// bit (j % 64) of validity[j / 64] is set if values[j] holds a value.
+  /// Dense runs are visited in slot order and runs without any value are
+  /// skipped. A sparse container is visited one value per call, in no
+  /// particular order.
+  template <typename Fn>
+  void for_each_chunk(Fn &&fn) const
+    requires(std::is_arithmetic_v<value_type> && !k_packed_bool)
+  {
+    if (m_kind == container_kind::sparse) {
+      static constexpr uint64_t k_one = 1;
+      for (const auto &[i, value] : m_map_container) {
+        fn(std::span<const value_type>(&value, 1),
+           std::span<const uint64_t>(&k_one, 1), i);
+      }
+      return;
+    }
+
+    // A run then crosses at most one deque block boundary.
+    static_assert(METALLDATA_MSR_DEQUE_BLOCK_SIZE >=
+                      k_chunk_slots * sizeof(value_type),
+                  "deque blocks must hold at least one chunk");
+
+    std::array<uint64_t, k_chunk_slots / k_word_bits> validity;
+    for (size_t base = 0; base < m_dense_size;) {
+      const size_t len = priv_contiguous_run(
+          base, std::min(k_chunk_slots, m_dense_size - base));
+      const size_t num_words = (len + k_word_bits - 1) / k_word_bits;
+      uint64_t     any       = 0;
+      for (size_t w = 0; w < num_words; ++w) {
+        validity[w] = priv_validity_word(base + w * k_word_bits);
+        if (w == num_words - 1 && len % k_word_bits != 0) {
+          validity[w] &= priv_bit(len) - 1;
+        }
+        any |= validity[w];
+      }
+      if (any != 0) {
+        fn(std::span<const value_type>(&m_deq_values[base], len),
+           std::span<const uint64_t>(validity.data(), num_words), base);
+      }
+      base += len;
+    }
+  }
+
   // Move value to the new container kind
   void convert(const container_kind &new_kind) {
     if (m_kind == new_kind) {
@@ -248,27 +341,34 @@ class series_container {
 
     if (new_kind == container_kind::sparse) {
       // Convert to sparse
-      for (size_t i = 0; i < m_deq_container.size(); ++i) {
-        if (!m_deq_container[i].empty) {
-          m_map_container[i] = std::move(m_deq_container[i].value);
+      for (size_t w = 0; w < m_validity.size(); ++w) {
+        for (uint64_t word = m_validity[w]; word != 0; word &= word - 1) {
+          const size_t i = w * k_word_bits + std::countr_zero(word);
+          if constexpr (k_packed_bool) {
+            m_map_container[i] = priv_test_bit(m_deq_values, i);
+          } else {
+            m_map_container[i] = std::move(m_deq_values[i]);
+          }
         }
-        m_n_items = 0;
       }
-      m_deq_container.clear();
-      m_n_items = 0;
+      m_validity.clear();
+      m_deq_values.clear();
+      m_n_items    = 0;
+      m_dense_size = 0;
     } else if (new_kind == container_kind::dense) {
       // Convert to dense
-      size_t max_index = 0;
-      for (const auto &pair : m_map_container) {
-        max_index = std::max(max_index, pair.first);
+      if (!m_map_container.empty()) {
+        size_t max_index = 0;
+        for (const auto &pair : m_map_container) {
+          max_index = std::max(max_index, pair.first);
+        }
+        priv_dense_resize(max_index + 1);
       }
-      const auto new_dense_size = max_index + 1;
-      m_deq_container.resize(new_dense_size);
-      m_n_items = new_dense_size;
       for (auto &pair : m_map_container) {
-        m_deq_container[pair.first].empty = false;
-        m_deq_container[pair.first].value = std::move(pair.second);
+        m_validity[pair.first / k_word_bits] |= priv_bit(pair.first);
+        priv_dense_store(pair.first, std::move(pair.second));
       }
+      m_n_items = m_map_container.size();
       m_map_container.clear();
     } else {
       throw std::runtime_error("Unknown container kind");
@@ -278,9 +378,95 @@ class series_container {
   }
 
  private:
+  static constexpr uint64_t priv_bit(const size_t i) {
+    return uint64_t(1) << (i % k_word_bits);
+  }
+
+  static bool priv_test_bit(const deque_type<uint64_t> &words,
+                            const size_t                i) {
+    return (words[i / k_word_bits] & priv_bit(i)) != 0;
+  }
+
+  bool priv_dense_valid(const size_t i) const {
+    return priv_test_bit(m_validity, i);
+  }
+
+  // Returns the 64 validity bits of slots [i, i + 64).
+  uint64_t priv_validity_word(const size_t i) const {
+    const size_t w     = i / k_word_bits;
+    const size_t shift = i % k_word_bits;
+    uint64_t     word  = m_validity[w] >> shift;
+    if (shift != 0 && w + 1 < m_validity.size()) {
+      word |= m_validity[w + 1] << (k_word_bits - shift);
+    }
+    return word;
+  }
+
+  // Returns the number of slots from 'base', at most 'max_len', whose values
+  // are contiguous in memory, i.e., do not cross a deque block boundary.
+  // The run is assumed to cross at most one boundary.
+  size_t priv_contiguous_run(const size_t base, const size_t max_len) const {
+    const value_type *first = &m_deq_values[base];
+    auto contiguous = [&](const size_t j) {
+      return &m_deq_values[base + j] == first + j;
+    };
+    if (contiguous(max_len - 1)) {
+      return max_len;
+    }
+    size_t lo = 1;
+    size_t hi = max_len - 1;
+    while (lo < hi) {
+      const size_t mid = lo + (hi - lo) / 2;
+      if (contiguous(mid)) {
+        lo = mid + 1;
+      } else {
+        hi = mid;
+      }
+    }
+    return lo;
+  }
+
+  // Grows the dense storage to hold 'n' slots; new slots are empty.
+  void priv_dense_resize(const size_t n) {
+    if (n <= m_dense_size) {
+      return;
+    }
+    const size_t num_words = (n + k_word_bits - 1) / k_word_bits;
+    m_validity.resize(num_words, 0);
+    if constexpr (k_packed_bool) {
+      m_deq_values.resize(num_words, 0);
+    } else {
+      m_deq_values.resize(n);
+    }
+    m_dense_size = n;
+  }
+
+  void priv_dense_mark_valid(const size_t i) {
+    priv_dense_resize(i + 1);
+    if (!priv_dense_valid(i)) {
+      m_validity[i / k_word_bits] |= priv_bit(i);
+      ++m_n_items;
+    }
+  }
+
+  void priv_dense_store(const size_t i, value_type value) {
+    if constexpr (k_packed_bool) {
+      if (value) {
+        m_deq_values[i / k_word_bits] |= priv_bit(i);
+      } else {
+        m_deq_values[i / k_word_bits] &= ~priv_bit(i);
+      }
+    } else {
+      m_deq_values[i] = std::move(value);
+    }
+  }
+
   container_kind m_kind{container_kind::dense};
-  size_t         m_n_items{0};  // Used only for the dense container
-  deque_type<value_with_flag> m_deq_container;
-  map_type<value_type>        m_map_container;
+  size_t         m_n_items{0};     // Used only for the dense container
+  size_t         m_dense_size{0};  // Number of dense slots
+  map_type<value_type>         m_map_container;
+  // Dense layout: one validity bit per slot, values packed separately
+  deque_type<uint64_t>         m_validity;
+  deque_type<dense_value_type> m_deq_values;
 };
-}  // namespace multiseries
\ No newline at end of file
+}  // namespace multiseries
@@ -0,0 +1,264 @@
+// Copyright Lawrence Livermore National Security, LLC and other MetallData
+// Project Developers. See the top-level COPYRIGHT file for details.
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <scoped_allocator>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+#include <boost/container/deque.hpp>
+#include <boost/container/string.hpp>
+#include <boost/container/vector.hpp>
+#include <boost/unordered/unordered_flat_map.hpp>
+
+#include <multiseries/multiseries_record.hpp>
+
+/// \file
+/// Persistent layouts of basic_record_store and series_container that predate
+/// basic_record_store::k_layout_version (layout version 0): one bool per
+/// record status, names found by scanning, and dense values stored next to
+/// an empty flag.  The classes mirror the old members exactly so that stores
+/// written by older versions can be read and migrated.  The constructors and
+/// setters exist only to build such stores in tests.
+
+namespace multiseries::legacy {
+namespace {
+namespace bc = boost::container;
+namespace cstr = compact_string;
+}  // namespace
+
+/// \brief series_container, layout version 0
+template <typename Value, typename Alloc>
+class series_container_v0 {
+ public:
+  using value_type = Value;
+
+  series_container_v0(const container_kind kind, const Alloc &alloc)
+      : m_kind(kind), m_deq_container(alloc), m_map_container(alloc) {}
+
+  container_kind kind() const { return m_kind; }
+
+  void set(const size_t i, const value_type &value) {
+    if (m_kind == container_kind::sparse) {
+      m_map_container[i] = value;
+      return;
+    }
+    if (i >= m_deq_container.size()) {
+      m_deq_container.resize(i + 1);
+    }
+    if (m_deq_container[i].empty) {
+      ++m_n_items;
+    }
+    m_deq_container[i].empty = false;
+    m_deq_container[i].value = value;
+  }
+
+  void erase(const size_t i) {
+    if (m_kind == container_kind::sparse) {
+      m_map_container.erase(i);
+    } else if (i < m_deq_container.size() && !m_deq_container[i].empty) {
+      m_deq_container[i].empty = true;
+      --m_n_items;
+    }
+  }
+
+  /// \brief Calls fn(i, value) for every stored value.
+  template <typename Fn>
+  void for_all(Fn fn) const {
+    if (m_kind == container_kind::sparse) {
+      for (const auto &[i, value] : m_map_container) {
+        fn(i, value);
+      }
+      return;
+    }
+    for (size_t i = 0; i < m_deq_container.size(); ++i) {
+      if (!m_deq_container[i].empty) {
+        fn(i, m_deq_container[i].value);
+      }
+    }
+  }
+
+ private:
+  template <typename T>
+  using other_allocator =
+    typename std::allocator_traits<Alloc>::template rebind_alloc<T>;
+
+  template <typename T>
+  using scp_allocator = std::scoped_allocator_adaptor<other_allocator<T>>;
+
+  struct value_with_flag {
+    bool       empty{true};
+    value_type value;
+  };
+
+  using deque_block_option_t =
+    bc::deque_options<bc::block_bytes<METALLDATA_MSR_DEQUE_BLOCK_SIZE>>::type;
+  template <typename T>
+  using deque_type = bc::deque<T, scp_allocator<T>, deque_block_option_t>;
+
+  template <typename T>
+  using map_type =
+    boost::unordered_flat_map<size_t, T, std::hash<size_t>,
+                              std::equal_to<size_t>,
+                              scp_allocator<std::pair<const size_t, T>>>;
+
+  container_kind              m_kind{container_kind::dense};
+  size_t                      m_n_items{0};
+  deque_type<value_with_flag> m_deq_container;
+  map_type<value_type>        m_map_container;
+};
+
+/// \brief basic_record_store, layout version 0
+template <typename Alloc>
+class record_store_v0 {
+ private:
+  template <typename T>
+  using other_allocator =
+    typename std::allocator_traits<Alloc>::template rebind_alloc<T>;
+
+  template <typename T>
+  using scp_allocator = std::scoped_allocator_adaptor<other_allocator<T>>;
+
+  using pointer_type = typename std::allocator_traits<Alloc>::pointer;
+
+  template <typename T>
+  using other_pointer_type =
+    typename std::pointer_traits<pointer_type>::template rebind<T>;
+
+  template <typename T>
+  using vector_type = bc::vector<T, scp_allocator<T>>;
+
+  using deque_block_option_t =
+    bc::deque_options<bc::block_bytes<METALLDATA_MSR_DEQUE_BLOCK_SIZE>>::type;
+  template <typename T>
+  using deque_type = bc::deque<T, scp_allocator<T>, deque_block_option_t>;
+
+  using container_variant =
+    std::variant<series_container_v0<bool, Alloc>,
+                 series_container_v0<int64_t, Alloc>,
+                 series_container_v0<double, Alloc>,
+                 series_container_v0<cstr::string_accessor, Alloc>>;
+
+  using string_type =
+    bc::basic_string<char, std::char_traits<char>, other_allocator<char>>;
+
+  struct series_header {
+    string_type       name;
+    container_variant container;
+  };
+
+  using string_store_pointer_type =
+    other_pointer_type<cstr::string_store<Alloc>>;
+
+ public:
+  using string_store_type = cstr::string_store<Alloc>;
+
+  record_store_v0(string_store_type *string_store, const Alloc &alloc)
+      : m_record_status(alloc), m_series(alloc), m_string_store(string_store) {}
+
+  size_t add_record() {
+    m_record_status.push_back(true);
+    return m_record_status.size() - 1;
+  }
+
+  void remove_record(const size_t id) {
+    for (auto &series : m_series) {
+      std::visit([id](auto &container) { container.erase(id); },
+                 series.container);
+    }
+    m_record_status[id] = false;
+  }
+
+  /// \brief Adds a series of type T (std::string_view for strings).
+  template <typename T>
+  size_t add_series(const std::string_view name, const container_kind kind) {
+    using V = std::conditional_t<std::is_same_v<T, std::string_view>,
+                                 cstr::string_accessor, T>;
+    const Alloc alloc(m_record_status.get_allocator());
+    m_series.push_back(
+      {.name = string_type(name.data(), name.size(), alloc),
+       .container = series_container_v0<V, Alloc>(kind, alloc)});
+    return m_series.size() - 1;
+  }
+
+  template <typename T>
+  void set(const size_t series_index, const size_t id, const T &value) {
+    std::visit(
+      [&](auto &container) {
+        using V = typename std::decay_t<decltype(container)>::value_type;
+        if constexpr (std::is_same_v<T, std::string_view> &&
+                      std::is_same_v<V, cstr::string_accessor>) {
+          container.set(id, cstr::add_string(value, *m_string_store));
+        } else if constexpr (std::is_same_v<T, V>) {
+          container.set(id, value);
+        }
+      },
+      m_series[series_index].container);
+  }
+
+  size_t num_record_slots() const { return m_record_status.size(); }
+
+  bool contains_record(const size_t id) const {
+    return m_record_status.size() > id && m_record_status[id];
+  }
+
+  /// \brief Calls fn(name, container) for every series, in index order.
+  template <typename Fn>
+  void for_all_series(Fn fn) const {
+    for (const auto &series : m_series) {
+      std::visit(
+        [&](const auto &container) {
+          fn(std::string_view(series.name.data(), series.name.size()),
+             container);
+        },
+        series.container);
+    }
+  }
+
+ private:
+  deque_type<bool>           m_record_status;
+  vector_type<series_header> m_series;
+  string_store_pointer_type  m_string_store;
+};
+
+/// \brief Copies a layout version 0 store into an empty current one.
+/// Record ids, series indices, kinds and removed records are preserved.
+template <typename Alloc>
+void migrate(const record_store_v0<Alloc> &from,
+             basic_record_store<Alloc>    &to) {
+  for (size_t i = 0; i < from.num_record_slots(); ++i) {
+    to.add_record();
+  }
+
+  from.for_all_series([&to](std::string_view name, const auto &container) {
+    using V = typename std::decay_t<decltype(container)>::value_type;
+    if constexpr (std::is_same_v<V, cstr::string_accessor>) {
+      auto idx = to.template add_series<std::string_view>(name,
+                                                          container.kind());
+      container.for_all([&](size_t i, const V &value) {
+        to.set(idx, i, value.to_view());
+      });
+    } else {
+      auto idx = to.template add_series<V>(name, container.kind());
+      container.for_all([&](size_t i, const V &value) {
+        to.set(idx, i, value);
+      });
+    }
+  });
+
+  for (size_t i = 0; i < from.num_record_slots(); ++i) {
+    if (!from.contains_record(i)) {
+      to.remove_record(i);
+    }
+  }
+}
+
+}  // namespace multiseries::legacy
@@ -6,17 +6,22 @@
 #pragma once
 
 #include <algorithm>
+#include <bit>
+#include <cstdint>
 #include <cstdlib>
 #include <deque>
+#include <limits>
 #include <memory>
 #include <numeric>
 #include <ranges>
 #include <scoped_allocator>
+#include <span>
 #include <stdexcept>
 #include <string>
 #include <string_view>
 #include <type_traits>
 #include <unordered_map>
+#include <utility>
 #include <variant>
 #include <vector>
 
@@ -67,6 +72,15 @@ class basic_record_store {
   using series_type =
     std::variant<std::monostate, bool, int64_t, double, std::string_view>;
 
+  /// Version of the persistent layout of this class and series_container.
+  /// Applications that persist a store should keep it alongside and check it
+  /// when reopening; legacy_record_store.hpp migrates version 0 stores.
+  static constexpr uint32_t k_layout_version = 1;
+
+  /// New ID of a removed record slot, see compact()
+  static constexpr record_id_type k_removed_record =
+    std::numeric_limits<record_id_type>::max();
+
  private:
   template <typename T>
   using vector_type = bc::vector<T, scp_allocator<T>>;
@@ -107,19 +121,57 @@ class basic_record_store {
   };
   using multiseries_main_container_type = vector_type<series_header>;
 
+  // Transparent hash and equality so the name index can be probed with a
+  // std::string_view without building a string_type.
+  struct series_name_hasher {
+    using is_transparent = void;
+    std::size_t operator()(const std::string_view name) const {
+      return std::hash<std::string_view>{}(name);
+    }
+    std::size_t operator()(const string_type &name) const {
+      return operator()(std::string_view(name.data(), name.size()));
+    }
+  };
+
+  struct series_name_equal {
+    using is_transparent = void;
+    template <typename L, typename R>
+    bool operator()(const L &left, const R &right) const {
+      return std::string_view(left.data(), left.size()) ==
+             std::string_view(right.data(), right.size());
+    }
+  };
+
+  // Series name -> index into m_series
+  using series_name_index_type = boost::unordered_flat_map<
+    string_type, series_index_type, series_name_hasher, series_name_equal,
+    scp_allocator<std::pair<const string_type, series_index_type>>>;
+
  public:
   explicit basic_record_store(string_store_type    *string_store,
                               const allocator_type &alloc = allocator_type())
-      : m_record_status(alloc), m_series(alloc), m_string_store(string_store) {}
+      : m_live_words(alloc),
+        m_series(alloc),
+        m_series_index(alloc),
+        m_string_store(string_store) {}
 
   record_id_type add_record() {
     // Does not increment container capacity yet
-    m_record_status.push_back(true);
-    return m_record_status.size() - 1;
+    const record_id_type id = m_num_record_slots++;
+    if (id % k_live_word_bits == 0) {
+      m_live_words.push_back(0);
+    }
+    m_live_words[id / k_live_word_bits] |= priv_live_bit(id);
+    ++m_num_records;
+    return id;
   }
 
   /// \brief Returns the maximum record index.
-  record_id_type max_index() { return m_record_status.size() - 1; }
+  record_id_type max_index() { return m_num_record_slots - 1; }
+
+  /// \brief Returns the number of record slots, including removed records.
+  /// Valid record IDs are in [0, num_record_slots()).
+  size_t num_record_slots() const { return m_num_record_slots; }
 
   /// \brief Add a series, or return the index of an existing one.
   /// \param series_name The name of the series
@@ -138,9 +190,10 @@ class basic_record_store {
 
     m_series.push_back(
       {.name = string_type(series_name.data(), series_name.size(),
-                           m_record_status.get_allocator()),
+                           m_live_words.get_allocator()),
        .container = series_container_type<series_type>(
-         kind, m_record_status.get_allocator())});
+         kind, m_live_words.get_allocator())});
+    m_series_index.emplace(m_series.back().name, m_series.size() - 1);
 
     return m_series.size() - 1;
   }
@@ -275,7 +328,10 @@ class basic_record_store {
       return false;
     }
 
+    m_series_index.erase(old_name);
     itr->name = new_name;
+    m_series_index.emplace(
+      itr->name, series_index_type(std::distance(m_series.begin(), itr)));
     return true;
   }
   std::optional<std::vector<series_index_type>> find_series(
@@ -294,9 +350,7 @@ class basic_record_store {
     return to_return;
   }
   //// Returns the number of records (rows)
-  size_t num_records() const {
-    return std::count(m_record_status.begin(), m_record_status.end(), true);
-  }
+  size_t num_records() const { return m_num_records; }
 
   /// \brief Returns the number of series (columns)
   size_t num_series() const { return m_series.size(); }
@@ -322,11 +376,29 @@ class basic_record_store {
 
     const auto &container =
       priv_get_series_container<series_type>(m_series[series_index].container);
-    for (size_t i = 0; i < m_record_status.size(); ++i) {
-      if (m_record_status[i] && container.contains(i)) {
+    priv_for_all_live([&](const record_id_type i) {
+      if (container.contains(i)) {
         series_func(i, container.at(i));
       }
+    });
+  }
+
+  /// \brief Scans a series in chunks of contiguous values.
+  /// func(values, validity, base_row) receives a std::span<const series_type>
+  /// holding rows [base_row, base_row + values.size()) and a
+  /// std::span<const uint64_t> where bit (j % 64) of validity[j / 64] is set if
+  /// values[j] holds a value. Removed records never hold values.
+  /// Only int64_t and double series can be scanned this way.
+  template <typename series_type, typename Fn>
+  void for_each_chunk(const series_index_type series_index, Fn &&func) const {
+    static_assert(std::is_same_v<series_type, int64_t> ||
+                    std::is_same_v<series_type, double>,
+                  "for_each_chunk() supports int64_t and double series");
+    if (series_index >= m_series.size()) {
+      throw std::runtime_error("Series not found");
     }
+    priv_get_series_container<series_type>(m_series[series_index].container)
+      .for_each_chunk(std::forward<Fn>(func));
   }
 
   // Change name
@@ -368,10 +440,7 @@ class basic_record_store {
     }
 
     const auto &series_item = *itr;
-    for (size_t i = 0; i < m_record_status.size(); ++i) {
-      if (!m_record_status[i]) {  // Just for performance optimization
-        continue;
-      }
+    priv_for_all_live([&](const record_id_type i) {
       std::visit(
         [&series_func, i](const auto &container) {
           if (!container.contains(i)) return;
@@ -384,7 +453,7 @@ class basic_record_store {
           }
         },
         series_item.container);
-    }
+    });
   }
 
   /// \brief for_all() across all series.
@@ -392,13 +461,10 @@ class basic_record_store {
   /// indicates a missing value.
   template <typename Fn>
   void for_all_dynamic(Fn func) const {
-    for (record_id_type i = 0; i < m_record_status.size(); ++i) {
-      if (!m_record_status[i]) {  // Just for performance optimization
-        continue;
-      }
+    priv_for_all_live([&](const record_id_type i) {
       auto row = get(i);
       func(i, row);
-    }
+    });
   }
 
   /// \brief for_all() across the entire container, for non-tombstoned rows.
@@ -407,12 +473,7 @@ class basic_record_store {
   /// could be nil for a given column.
   template <typename Fn>
   void for_all_rows(Fn func) const {
-    for (size_t i = 0; i < m_record_status.size(); ++i) {
-      if (!m_record_status[i]) {  // Just for performance optimization
-        continue;
-      }
-      func(i);
-    }
+    priv_for_all_live(func);
   }
 
   /// \brief Returns if a series exists associated with the name
@@ -426,7 +487,8 @@ class basic_record_store {
 
   /// \brief Returns if a series exists associated with the name
   bool contains_record(const record_id_type id) const {
-    return m_record_status.size() > id && m_record_status[id];
+    return m_num_record_slots > id &&
+           (m_live_words[id / k_live_word_bits] & priv_live_bit(id)) != 0;
   }
 
   /// \brief Returns the series names
@@ -463,17 +525,30 @@ class basic_record_store {
       return false;
     }
 
-    m_series.erase(itr);
-    return true;
+    return remove_series(
+      series_index_type(std::distance(m_series.begin(), itr)));
   }
 
   bool remove_series(const series_index_type series_index) {
-    return m_series.erase(m_series.begin() + series_index) != m_series.end();
+    if (series_index >= m_series.size()) {
+      return false;
+    }
+    m_series_index.erase(
+      std::string_view(m_series[series_index].name.data(),
+                       m_series[series_index].name.size()));
+    m_series.erase(m_series.begin() + series_index);
+    // Later series shifted down by one.
+    for (auto &[name, index] : m_series_index) {
+      if (index > series_index) {
+        --index;
+      }
+    }
+    return true;
   }
 
   /// \brief Remove a record, destroy all series data of the record
   bool remove_record(const record_id_type record_id) {
-    if (record_id >= m_record_status.size()) {
+    if (record_id >= m_num_record_slots) {
       return false;
     }
 
@@ -482,10 +557,60 @@ class basic_record_store {
                  series.container);
     }
 
-    m_record_status[record_id] = false;
+    if (contains_record(record_id)) {
+      m_live_words[record_id / k_live_word_bits] &= ~priv_live_bit(record_id);
+      --m_num_records;
+    }
     return true;
   }
 
+  /// \brief Renumbers the live records to [0, num_records()), keeping their
+  /// order, and rebuilds every series without the removed slots.
+  /// \return The new ID of each old record slot, k_removed_record for
+  /// removed ones
+  std::vector<record_id_type> compact() {
+    std::vector<record_id_type> new_ids(m_num_record_slots, k_removed_record);
+    record_id_type              next = 0;
+    priv_for_all_live([&](const record_id_type i) { new_ids[i] = next++; });
+
+    for (auto &series : m_series) {
+      std::visit(
+        [&](auto &container) {
+          using C = std::decay_t<decltype(container)>;
+          C compacted(container.kind(), m_live_words.get_allocator());
+          priv_for_all_live([&](const record_id_type i) {
+            if (container.contains(i)) {
+              compacted.set(new_ids[i], container.at(i));
+            }
+          });
+          container = std::move(compacted);
+        },
+        series.container);
+    }
+
+    m_live_words.assign((next + k_live_word_bits - 1) / k_live_word_bits,
+                        ~uint64_t(0));
+    if (next % k_live_word_bits != 0) {
+      m_live_words.back() = priv_live_bit(next) - 1;
+    }
+    m_live_words.shrink_to_fit();
+    m_num_record_slots = next;
+    m_num_records = next;
+    return new_ids;
+  }
+
+  /// \brief Returns the approximate bytes held by the records and series.
+  /// Strings are shared through the string store and not included.
+  size_t storage_bytes() const {
+    size_t bytes = m_live_words.size() * sizeof(uint64_t);
+    for (const auto &series : m_series) {
+      bytes += std::visit(
+        [](const auto &container) { return container.storage_bytes(); },
+        series.container);
+    }
+    return bytes;
+  }
+
   /// \brief Check if the series is of a specific type.
   /// Returns false if the series does not exist.
   template <typename series_type>
@@ -536,10 +661,30 @@ class basic_record_store {
   /// load-factor = non-None items / #of records.
   /// This one does not consider
   double load_factor(const std::string_view series_name) const {
-    return double(size(series_name)) / m_record_status.size();
+    return double(size(series_name)) / m_num_record_slots;
   }
 
  private:
+  static constexpr size_t k_live_word_bits = 64;
+
+  static constexpr uint64_t priv_live_bit(const record_id_type id) {
+    return uint64_t(1) << (id % k_live_word_bits);
+  }
+
+  /// \brief Calls func(id) for every live record in id order.
+  /// Dead words are skipped as a whole.
+  template <typename Fn>
+  void priv_for_all_live(Fn &&func) const {
+    for (size_t w = 0; w < m_live_words.size(); ++w) {
+      uint64_t word = m_live_words[w];
+      while (word != 0) {
+        func(record_id_type(w * k_live_word_bits + std::countr_zero(word)));
+        // Drop the visited bit and any record func removed.
+        word &= (word - 1) & m_live_words[w];
+      }
+    }
+  }
+
   template <class series_type>
   static constexpr void priv_series_type_check() {
     static_assert(std::is_same_v<series_type, bool> ||
@@ -551,22 +696,20 @@ class basic_record_store {
 
   multiseries_main_container_type::iterator priv_find_series(
     const std::string_view series_name) {
-    for (auto itr = m_series.begin(); itr != m_series.end(); ++itr) {
-      if (itr->name == series_name) {
-        return itr;
-      }
+    auto itr = m_series_index.find(series_name);
+    if (itr == m_series_index.end()) {
+      return m_series.end();
     }
-    return m_series.end();
+    return m_series.begin() + itr->second;
   }
 
   multiseries_main_container_type::const_iterator priv_find_series(
     const std::string_view series_name) const {
-    for (auto itr = m_series.cbegin(); itr != m_series.cend(); ++itr) {
-      if (itr->name == series_name) {
-        return itr;
-      }
+    auto itr = m_series_index.find(series_name);
+    if (itr == m_series_index.end()) {
+      return m_series.cend();
     }
-    return m_series.cend();
+    return m_series.cbegin() + itr->second;
   }
 
   template <typename series_type>
@@ -604,16 +747,20 @@ class basic_record_store {
                             const series_type   &value) {
     if constexpr (std::is_same_v<series_type, std::string_view>) {
       auto accessor = cstr::add_string(value, *m_string_store);
-      priv_get_series_container<series_type>(series.container)[record_id] =
-        accessor;
+      priv_get_series_container<series_type>(series.container)
+        .set(record_id, accessor);
     } else {
-      priv_get_series_container<series_type>(series.container)[record_id] =
-        value;
+      priv_get_series_container<series_type>(series.container)
+        .set(record_id, value);
     }
   }
 
-  deque_type<bool>                m_record_status;
+  // Liveness of each record slot, 64 slots per word
+  vector_type<uint64_t>           m_live_words;
+  size_t                          m_num_record_slots = 0;
+  size_t                          m_num_records = 0;
   multiseries_main_container_type m_series;
+  series_name_index_type          m_series_index;
   string_store_pointer_type       m_string_store;
 };
 
@@ -13,6 +13,7 @@
 #include <scoped_allocator>
 #include <string_view>
 #include <utility>
+#include <vector>
 
 #include <boost/container/string.hpp>
 #include <boost/container/vector.hpp>
@@ -244,6 +245,29 @@ class string_store {
     return std::to_address(str_holder.str());
   }
 
+  /// \brief Add every string in [first, last) that is not in the store yet.
+  /// The strings are grouped by set first so that each set grows once.
+  template <typename InputIt>
+  void add_all(InputIt first, InputIt last) {
+    std::vector<std::vector<std::string_view> > by_set(k_num_string_sets);
+    for (; first != last; ++first) {
+      const std::string_view str(*first);
+      by_set[priv_str_set_no(str)].push_back(str);
+    }
+    for (size_t set_no = 0; set_no < by_set.size(); ++set_no) {
+      if (by_set[set_no].empty()) {
+        continue;
+      }
+      auto &set = m_str_sets_table[set_no];
+      set.reserve(set.size() + by_set[set_no].size());
+      for (const auto &str : by_set[set_no]) {
+        if (!set.contains(str)) {
+          set.emplace(priv_allocate_string(str));
+        }
+      }
+    }
+  }
+
   const char *find(std::string_view str) const {
     auto &set = m_str_sets_table[priv_str_set_no(str)];
     auto  itr = set.find(str);
@@ -0,0 +1,91 @@
+// Copyright Lawrence Livermore National Security, LLC and other MetallData
+// Project Developers. See the top-level COPYRIGHT file for details.
+//
+// SPDX-License-Identifier: MIT
+
+#define WITH_YGM 1
+#include <clippy/clippy.hpp>
+#include <stdexcept>
+#include <ygm/comm.hpp>
+#include <metalldata/metall_graph.hpp>
+#include <format>
+
+static const std::string method_name = "collapse_edges";
+static const std::string state_name = "INTERNAL";
+static const std::string sel_state_name = "selectors";
+
+int main(int argc, char** argv) try {
+  ygm::comm comm(&argc, &argv);
+
+  clippy::clippy clip{method_name,
+                      "Merges parallel edges and aggregates edge series"};
+  clip.add_required_state<std::string>("path", "Storage path for MetallGraph");
+  clip.add_optional<boost::json::object>(
+    "aggs",
+    "Aggregations, as {output: [op, input]} with op one of count, sum, min, "
+    "max, first; count takes no input",
+    boost::json::object{});
+  clip.add_optional<boost::json::object>("where", "where clause",
+                                         boost::json::object{});
+
+  // no object-state requirements in constructor
+  if (clip.parse(argc, argv, comm)) {
+    return 0;
+  }
+
+  auto path = clip.get_state<std::string>("path");
+  auto aggs_obj = clip.get<boost::json::object>("aggs");
+  auto where = clip.get<boost::json::object>("where");
+
+  metalldata::metall_graph::where_clause where_c;
+  if (where.contains("rule")) {
+    where_c = metalldata::metall_graph::where_clause(where["rule"]);
+  }
+
+  auto qualify = [](std::string_view name) {
+    metalldata::metall_graph::series_name sname(name);
+    if (sname.prefix().empty()) {
+      sname = metalldata::metall_graph::series_name("edge", name);
+    }
+    return sname;
+  };
+
+  std::vector<metalldata::metall_graph::edge_aggregation> aggs;
+  for (const auto& [out, spec] : aggs_obj) {
+    const auto* arr = spec.if_array();
+    bool        valid = arr != nullptr && !arr->empty() && arr->size() <= 2;
+    for (size_t i = 0; valid && i < arr->size(); ++i) {
+      valid = (*arr)[i].is_string();
+    }
+    if (!valid) {
+      comm.cerr0("Invalid aggregation for ", std::string(out));
+      return -1;
+    }
+    std::string op((*arr)[0].as_string());
+    std::string in = arr->size() == 2 ? std::string((*arr)[1].as_string())
+                                      : std::string(out);
+    aggs.push_back({qualify(out), op, qualify(in)});
+  }
+
+  metalldata::metall_graph mg(comm, path, false);
+
+  auto rc = mg.collapse_edges(aggs, where_c);
+
+  if (!rc) {
+    comm.cerr0(rc.error());
+    return -1;
+  }
+
+  for (const auto& [warn, count] : rc.warnings()) {
+    comm.cerr0(std::format("{} : {}", warn, count));
+  }
+
+  clip.update_selectors(mg.get_selector_info());
+  clip.to_return(rc.value());
+
+  return 0;
+} catch (const std::runtime_error& e) {
+  std::cerr << "Error in execution: " << e.what() << "; aborting.\n";
+} catch (...) {
+  std::cerr << "Unknown error in execution; aborting.\n";
+}
@@ -0,0 +1,51 @@
+// Copyright Lawrence Livermore National Security, LLC and other MetallData
+// Project Developers. See the top-level COPYRIGHT file for details.
+//
+// SPDX-License-Identifier: MIT
+
+#define WITH_YGM 1
+#include <clippy/clippy.hpp>
+#include <stdexcept>
+#include <ygm/comm.hpp>
+#include <metalldata/metall_graph.hpp>
+#include <format>
+
+static const std::string method_name = "compact";
+static const std::string state_name = "INTERNAL";
+static const std::string sel_state_name = "selectors";
+
+int main(int argc, char** argv) try {
+  ygm::comm comm(&argc, &argv);
+
+  clippy::clippy clip{method_name,
+                      "Renumbers records to drop erased edges and nodes and "
+                      "releases their storage"};
+  clip.add_required_state<std::string>("path", "Storage path for MetallGraph");
+
+  // no object-state requirements in constructor
+  if (clip.parse(argc, argv, comm)) {
+    return 0;
+  }
+
+  auto path = clip.get_state<std::string>("path");
+
+  metalldata::metall_graph mg(comm, path, false);
+
+  auto rc = mg.compact();
+
+  if (!rc) {
+    comm.cerr0(rc.error());
+    return -1;
+  }
+
+  for (const auto& [warn, count] : rc.warnings()) {
+    comm.cerr0(std::format("{} : {}", warn, count));
+  }
+
+  clip.to_return(rc.value());
+  return 0;
+} catch (const std::runtime_error& e) {
+  std::cerr << "Error in execution: " << e.what() << "; aborting.\n";
+} catch (...) {
+  std::cerr << "Unknown error in execution; aborting.\n";
+}
@@ -0,0 +1,81 @@
+// Copyright Lawrence Livermore National Security, LLC and other MetallData
+// Project Developers. See the top-level COPYRIGHT file for details.
+//
+// SPDX-License-Identifier: MIT
+
+#define WITH_YGM 1
+#include <clippy/clippy.hpp>
+#include <stdexcept>
+#include <ygm/comm.hpp>
+#include <metalldata/metall_graph.hpp>
+#include <format>
+#include <optional>
+#include <string>
+
+static const std::string method_name = "edge_similarity";
+static const std::string state_name = "INTERNAL";
+static const std::string sel_state_name = "selectors";
+
+int main(int argc, char** argv) try {
+  ygm::comm comm(&argc, &argv);
+
+  clippy::clippy clip{method_name,
+                      "Writes common-neighbor, Jaccard and Adamic-Adar scores "
+                      "of edge endpoints to edge series"};
+  clip.add_required_state<std::string>("path", "Storage path for MetallGraph");
+  clip.add_optional<std::string>(
+    "common", "Output edge series for common neighbor counts", "");
+  clip.add_optional<std::string>("jaccard",
+                                 "Output edge series for Jaccard", "");
+  clip.add_optional<std::string>("adamic_adar",
+                                 "Output edge series for Adamic-Adar", "");
+  clip.add_optional<boost::json::object>("where", "where clause",
+                                         boost::json::object{});
+
+  // no object-state requirements in constructor
+  if (clip.parse(argc, argv, comm)) {
+    return 0;
+  }
+
+  auto path = clip.get_state<std::string>("path");
+  auto where = clip.get<boost::json::object>("where");
+
+  metalldata::metall_graph::where_clause where_c;
+  if (where.contains("rule")) {
+    where_c = metalldata::metall_graph::where_clause(where["rule"]);
+  }
+
+  auto output = [&](const std::string& arg)
+    -> std::optional<metalldata::metall_graph::series_name> {
+    auto name = clip.get<std::string>(arg);
+    if (name.empty()) {
+      return std::nullopt;
+    }
+    metalldata::metall_graph::series_name sname(name);
+    if (sname.prefix().empty()) {
+      sname = metalldata::metall_graph::series_name("edge", name);
+    }
+    return sname;
+  };
+
+  metalldata::metall_graph mg(comm, path, false);
+
+  auto rc = mg.edge_similarity(output("common"), output("jaccard"),
+                               output("adamic_adar"), where_c);
+
+  if (!rc) {
+    comm.cerr0(rc.error());
+    return -1;
+  }
+
+  for (const auto& [warn, count] : rc.warnings()) {
+    comm.cerr0(std::format("{} : {}", warn, count));
+  }
+
+  clip.update_selectors(mg.get_selector_info());
+  return 0;
+} catch (const std::runtime_error& e) {
+  std::cerr << "Error in execution: " << e.what() << "; aborting.\n";
+} catch (...) {
+  std::cerr << "Unknown error in execution; aborting.\n";
+}
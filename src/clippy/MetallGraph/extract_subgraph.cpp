@@ -0,0 +1,79 @@
+// Copyright Lawrence Livermore National Security, LLC and other MetallData
+// Project Developers. See the top-level COPYRIGHT file for details.
+//
+// SPDX-License-Identifier: MIT
+
+#define WITH_YGM 1
+#include <clippy/clippy.hpp>
+#include <stdexcept>
+#include <ygm/comm.hpp>
+#include <metalldata/metall_graph.hpp>
+#include <format>
+
+static const std::string method_name = "extract_subgraph";
+static const std::string state_name = "INTERNAL";
+static const std::string sel_state_name = "selectors";
+
+int main(int argc, char** argv) try {
+  ygm::comm comm(&argc, &argv);
+
+  clippy::clippy clip{method_name,
+                      "Copies the selected subgraph into a new MetallGraph"};
+  clip.add_required_state<std::string>("path", "Storage path for MetallGraph");
+  clip.add_required<std::string>("dest_path",
+                                 "Storage path for the new MetallGraph");
+  clip.add_optional<std::vector<std::string>>(
+    "series", "Node and edge series to copy (default all)", {});
+  clip.add_optional<boost::json::object>("where", "where clause",
+                                         boost::json::object{});
+
+  // no object-state requirements in constructor
+  if (clip.parse(argc, argv, comm)) {
+    return 0;
+  }
+
+  // if we don't specify it at all, copy everything
+  bool all = !clip.has_argument("series");
+
+  auto path = clip.get_state<std::string>("path");
+  auto dest_path = clip.get<std::string>("dest_path");
+  auto where = clip.get<boost::json::object>("where");
+
+  metalldata::metall_graph::where_clause where_c;
+  if (where.contains("rule")) {
+    where_c = metalldata::metall_graph::where_clause(where["rule"]);
+  }
+
+  metalldata::metall_graph mg(comm, path, false);
+
+  std::vector<metalldata::metall_graph::series_name> series;
+  if (!all) {
+    for (const auto& s : clip.get<std::vector<std::string>>("series")) {
+      series.emplace_back(s);
+    }
+  } else {
+    series = mg.get_node_series_names();
+    auto edge_series = mg.get_edge_series_names();
+    series.insert(series.end(), edge_series.begin(), edge_series.end());
+  }
+
+  auto result = mg.extract_subgraph(where_c, dest_path, series);
+
+  if (!result) {
+    comm.cerr0() << "Error: " << result.error() << std::endl;
+    return 1;
+  }
+
+  for (const auto& [msg, count] : result.warnings()) {
+    comm.cerr0() << "Warning: " << msg << " (occurred " << count << " times)"
+                 << std::endl;
+  }
+
+  clip.to_return(result.value());
+
+  return 0;
+} catch (const std::runtime_error& e) {
+  std::cerr << "Error in execution: " << e.what() << "; aborting.\n";
+} catch (...) {
+  std::cerr << "Unknown error in execution; aborting.\n";
+}
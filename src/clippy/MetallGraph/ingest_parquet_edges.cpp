@@ -29,6 +29,11 @@ int main(int argc, char **argv) try {
                           "True if edges are directed (default true)", true);
   clip.add_optional<std::vector<std::string>>(
     "metadata", "Column names of additional fields to ingest", {});
+  clip.add_optional<std::string>(
+    "repartition",
+    "Move edges to the owner of their source or target endpoint after "
+    "ingest: source, target, or empty for none",
+    "");
 
   // no object-state requirements in constructor
   if (clip.parse(argc, argv, comm)) {
@@ -46,6 +51,7 @@ int main(int argc, char **argv) try {
   auto col_v = clip.get<std::string>("col_v");
   auto directed = clip.get<bool>("directed");
   auto meta_str = clip.get<std::vector<std::string>>("metadata");
+  auto repartition = clip.get<std::string>("repartition");
 
   metalldata::metall_graph mg(comm, path, false);
 
@@ -72,6 +78,15 @@ int main(int argc, char **argv) try {
     comm.cerr0(std::format("{} : {}", warn, count));
   }
 
+  if (!repartition.empty()) {
+    auto rp = mg.repartition_edges(repartition);
+    if (!rp) {
+      comm.cerr0(rp.error());
+      return -1;
+    }
+    rc.value().merge(rp.value());
+  }
+
   clip.update_selectors(mg.get_selector_info());
 
   // TODO: the return_info dict vals are std::any. This needs explicit JSON
@@ -0,0 +1,78 @@
+// Copyright Lawrence Livermore National Security, LLC and other MetallData
+// Project Developers. See the top-level COPYRIGHT file for details.
+//
+// SPDX-License-Identifier: MIT
+
+#define WITH_YGM 1
+#include <clippy/clippy.hpp>
+#include <stdexcept>
+#include <ygm/comm.hpp>
+#include <metalldata/metall_graph.hpp>
+#include <format>
+
+static const std::string method_name = "join_node_series_to_edges";
+static const std::string state_name = "INTERNAL";
+static const std::string sel_state_name = "selectors";
+
+int main(int argc, char** argv) try {
+  ygm::comm comm(&argc, &argv);
+
+  clippy::clippy clip{method_name,
+                      "Copies a node series onto edges from an endpoint"};
+  clip.add_required_state<std::string>("path", "Storage path for MetallGraph");
+  clip.add_required<std::string>("series", "Input node series name");
+  clip.add_optional<std::string>("endpoint", "Endpoint to copy from: u or v",
+                                 "u");
+  clip.add_optional<std::string>(
+    "output", "Output edge series name (default: <endpoint>_<series>)", "");
+  clip.add_optional<boost::json::object>("where", "where clause",
+                                         boost::json::object{});
+
+  // no object-state requirements in constructor
+  if (clip.parse(argc, argv, comm)) {
+    return 0;
+  }
+
+  auto path = clip.get_state<std::string>("path");
+  auto series = clip.get<std::string>("series");
+  auto endpoint = clip.get<std::string>("endpoint");
+  auto output = clip.get<std::string>("output");
+  auto where = clip.get<boost::json::object>("where");
+
+  metalldata::metall_graph::where_clause where_c;
+  if (where.contains("rule")) {
+    where_c = metalldata::metall_graph::where_clause(where["rule"]);
+  }
+
+  metalldata::metall_graph::series_name nname(series);
+  if (nname.prefix().empty()) {
+    nname = metalldata::metall_graph::series_name("node", series);
+  }
+  if (output.empty()) {
+    output = std::format("{}_{}", endpoint, nname.unqualified());
+  }
+  metalldata::metall_graph::series_name ename(output);
+  if (ename.prefix().empty()) {
+    ename = metalldata::metall_graph::series_name("edge", output);
+  }
+
+  metalldata::metall_graph mg(comm, path, false);
+
+  auto rc = mg.join_node_series_to_edges(nname, endpoint, ename, where_c);
+
+  if (!rc) {
+    comm.cerr0(rc.error());
+    return -1;
+  }
+
+  for (const auto& [warn, count] : rc.warnings()) {
+    comm.cerr0(std::format("{} : {}", warn, count));
+  }
+
+  clip.update_selectors(mg.get_selector_info());
+  return 0;
+} catch (const std::runtime_error& e) {
+  std::cerr << "Error in execution: " << e.what() << "; aborting.\n";
+} catch (...) {
+  std::cerr << "Unknown error in execution; aborting.\n";
+}
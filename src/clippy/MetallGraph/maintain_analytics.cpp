@@ -0,0 +1,55 @@
+// Copyright Lawrence Livermore National Security, LLC and other MetallData
+// Project Developers. See the top-level COPYRIGHT file for details.
+//
+// SPDX-License-Identifier: MIT
+
+#define WITH_YGM 1
+#include <clippy/clippy.hpp>
+#include <stdexcept>
+#include <ygm/comm.hpp>
+#include <metalldata/metall_graph.hpp>
+
+static const std::string method_name = "maintain_analytics";
+
+int main(int argc, char **argv) try {
+  ygm::comm comm(&argc, &argv);
+
+  clippy::clippy clip{
+    method_name,
+    "Enables or disables connected component and degree series "
+    "(node.maintained_cc, node.maintained_in_degree, "
+    "node.maintained_out_degree) kept current across ingests"};
+  clip.add_required_state<std::string>("path", "Storage path for MetallGraph");
+  clip.add_optional<bool>("enable", "Enable (true) or disable (false)", true);
+
+  // no object-state requirements in constructor
+  if (clip.parse(argc, argv, comm)) {
+    return 0;
+  }
+
+  auto path = clip.get_state<std::string>("path");
+  auto enable = clip.get<bool>("enable");
+
+  metalldata::metall_graph mg(comm, path, false);
+
+  if (enable) {
+    auto rc = mg.enable_maintained_analytics();
+    if (!rc) {
+      comm.cerr0(rc.error());
+      return -1;
+    }
+    for (const auto &[warn, count] : rc.warnings()) {
+      comm.cerr0(std::format("{} : {}", warn, count));
+    }
+  } else {
+    mg.disable_maintained_analytics();
+  }
+
+  clip.update_selectors(mg.get_selector_info());
+
+  return 0;
+} catch (const std::runtime_error &e) {
+  std::cerr << "Error in execution: " << e.what() << "; aborting.\n";
+} catch (...) {
+  std::cerr << "Unknown error in execution; aborting.\n";
+}
@@ -0,0 +1,79 @@
+// Copyright Lawrence Livermore National Security, LLC and other MetallData
+// Project Developers. See the top-level COPYRIGHT file for details.
+//
+// SPDX-License-Identifier: MIT
+
+#define WITH_YGM 1
+#include <clippy/clippy.hpp>
+#include <stdexcept>
+#include <ygm/comm.hpp>
+#include <metalldata/metall_graph.hpp>
+
+static const std::string method_name = "pagerank";
+
+int main(int argc, char **argv) try {
+  ygm::comm comm(&argc, &argv);
+
+  clippy::clippy clip{method_name,
+                      "Computes PageRank, or personalized PageRank if seeds "
+                      "are given"};
+  clip.add_required_state<std::string>("path", "Storage path for MetallGraph");
+  clip.add_required<std::string>("output", "Output node series name");
+  clip.add_optional<double>("damping", "Damping factor", 0.85);
+  clip.add_optional<double>("tol", "L1 convergence tolerance", 1e-6);
+  clip.add_optional<size_t>("max_iter", "Maximum number of iterations", 100);
+  clip.add_optional<std::vector<std::string>>(
+    "seeds", "Source node ids for personalized PageRank",
+    std::vector<std::string>{});
+  clip.add_optional<boost::json::object>("where", "where clause",
+                                         boost::json::object{});
+
+  // no object-state requirements in constructor
+  if (clip.parse(argc, argv, comm)) {
+    return 0;
+  }
+
+  auto path = clip.get_state<std::string>("path");
+  auto output = clip.get<std::string>("output");
+  auto damping = clip.get<double>("damping");
+  auto tol = clip.get<double>("tol");
+  auto max_iter = clip.get<size_t>("max_iter");
+  auto seeds = clip.get<std::vector<std::string>>("seeds");
+  auto where = clip.get<boost::json::object>("where");
+
+  metalldata::metall_graph::where_clause where_c;
+  if (where.contains("rule")) {
+    where_c = metalldata::metall_graph::where_clause(where["rule"]);
+  }
+
+  metalldata::metall_graph              mg(comm, path, false);
+  metalldata::metall_graph::series_name sname(output);
+  if (sname.prefix().empty()) {
+    sname = metalldata::metall_graph::series_name("node", output);
+  }
+  if (!sname.is_node_series()) {
+    comm.cerr0("Invalid node series name: ", sname.qualified());
+    return -1;
+  }
+
+  auto rc = seeds.empty() ? mg.pagerank(sname, damping, tol, max_iter, where_c)
+                          : mg.personalized_pagerank(sname, seeds, damping, tol,
+                                                     max_iter, where_c);
+
+  if (!rc) {
+    comm.cerr0(rc.error());
+    return -1;
+  }
+
+  for (const auto &[warn, count] : rc.warnings()) {
+    comm.cerr0(std::format("{} : {}", warn, count));
+  }
+
+  clip.update_selectors(mg.get_selector_info());
+
+  return 0;
+} catch (const std::runtime_error &e) {
+  std::cerr << "Error in execution: " << e.what() << "; aborting.\n";
+} catch (...) {
+  std::cerr << "Unknown error in execution; aborting.\n";
+}
@@ -0,0 +1,109 @@
+// Copyright Lawrence Livermore National Security, LLC and other MetallData
+// Project Developers. See the top-level COPYRIGHT file for details.
+//
+// SPDX-License-Identifier: MIT
+
+#define WITH_YGM 1
+#include <clippy/clippy.hpp>
+#include <stdexcept>
+#include <ygm/comm.hpp>
+#include <metalldata/metall_graph.hpp>
+#include <boost/json.hpp>
+#include <format>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+static const std::string method_name = "pair_similarity";
+static const std::string state_name = "INTERNAL";
+static const std::string sel_state_name = "selectors";
+
+int main(int argc, char** argv) try {
+  ygm::comm comm(&argc, &argv);
+
+  clippy::clippy clip{method_name,
+                      "Returns common-neighbor, Jaccard and Adamic-Adar "
+                      "scores of node pairs"};
+  clip.add_required_state<std::string>("path", "Storage path for MetallGraph");
+  clip.add_optional<std::vector<std::vector<std::string>>>(
+    "pairs",
+    "[u, v] node pairs to score (default: all non-adjacent pairs at "
+    "distance two)",
+    {});
+  clip.add_optional<boost::json::object>("where", "where clause",
+                                         boost::json::object{});
+  clip.add_optional<size_t>("limit", "Limit number of rows returned", 1000);
+
+  // no object-state requirements in constructor
+  if (clip.parse(argc, argv, comm)) {
+    return 0;
+  }
+
+  auto path = clip.get_state<std::string>("path");
+  auto where = clip.get<boost::json::object>("where");
+  auto limit = clip.get<size_t>("limit");
+
+  metalldata::metall_graph::where_clause where_c;
+  if (where.contains("rule")) {
+    where_c = metalldata::metall_graph::where_clause(where["rule"]);
+  }
+
+  std::optional<std::vector<std::pair<std::string, std::string>>> pairs;
+  if (clip.has_argument("pairs")) {
+    pairs.emplace();
+    for (const auto& p :
+         clip.get<std::vector<std::vector<std::string>>>("pairs")) {
+      if (p.size() != 2) {
+        comm.cerr0("Each pair must have exactly two node ids");
+        return -1;
+      }
+      pairs->emplace_back(p[0], p[1]);
+    }
+  }
+
+  metalldata::metall_graph mg(comm, path, false);
+
+  auto rc = mg.pair_similarity(pairs, where_c);
+
+  if (!rc) {
+    comm.cerr0(rc.error());
+    return -1;
+  }
+
+  for (const auto& [warn, count] : rc.warnings()) {
+    comm.cerr0(std::format("{} : {}", warn, count));
+  }
+
+  std::vector<std::vector<metalldata::metall_graph::data_types>> rows;
+  rc.value().gather(rows, 0);
+  if (limit != 0 && rows.size() > limit) {
+    rows.resize(limit);
+  }
+
+  static const std::vector<std::string> keys{
+    "u", "v", "common_neighbors", "jaccard", "adamic_adar"};
+  boost::json::array json_rows;
+  json_rows.reserve(rows.size());
+  for (const auto& row : rows) {
+    boost::json::object rowmap;
+    for (size_t i = 0; i < row.size() && i < keys.size(); ++i) {
+      std::visit(
+        [&](const auto& val) {
+          if constexpr (!std::is_same_v<std::decay_t<decltype(val)>,
+                                        std::monostate>) {
+            rowmap[keys[i]] = val;
+          }
+        },
+        row[i]);
+    }
+    json_rows.emplace_back(rowmap);
+  }
+  clip.to_return(json_rows);
+
+  return 0;
+} catch (const std::runtime_error& e) {
+  std::cerr << "Error in execution: " << e.what() << "; aborting.\n";
+} catch (...) {
+  std::cerr << "Unknown error in execution; aborting.\n";
+}
@@ -0,0 +1,83 @@
+// Copyright Lawrence Livermore National Security, LLC and other MetallData
+// Project Developers. See the top-level COPYRIGHT file for details.
+//
+// SPDX-License-Identifier: MIT
+
+#define WITH_YGM 1
+#include <clippy/clippy.hpp>
+#include <stdexcept>
+#include <ygm/comm.hpp>
+#include <ygm/detail/collective.hpp>
+#include <metalldata/metall_graph.hpp>
+#include <format>
+
+static const std::string method_name = "random_walks";
+static const std::string state_name = "INTERNAL";
+static const std::string sel_state_name = "selectors";
+
+int main(int argc, char** argv) try {
+  ygm::comm comm(&argc, &argv);
+
+  clippy::clippy clip{method_name,
+                      "Writes random walks (node2vec if p or q is not 1) to "
+                      "parquet files"};
+  clip.add_required_state<std::string>("path", "Storage path for MetallGraph");
+  clip.add_required<std::string>("output_path", "Path to parquet output");
+  clip.add_optional<size_t>("num_walks", "Walks per start node", 10);
+  clip.add_optional<size_t>("walk_len", "Maximum nodes per walk", 80);
+  clip.add_optional<double>("p", "node2vec return parameter", 1.0);
+  clip.add_optional<double>("q", "node2vec in-out parameter", 1.0);
+  clip.add_optional<uint64_t>("seed", "Random seed", 0);
+  clip.add_optional<boost::json::object>("where", "where clause",
+                                         boost::json::object{});
+  clip.add_optional<bool>(
+    "overwrite",
+    "If true, overwrite the output file if it exists (default false)", false);
+
+  // no object-state requirements in constructor
+  if (clip.parse(argc, argv, comm)) {
+    return 0;
+  }
+
+  auto path = clip.get_state<std::string>("path");
+  auto output_path = clip.get<std::string>("output_path");
+  auto num_walks = clip.get<size_t>("num_walks");
+  auto walk_len = clip.get<size_t>("walk_len");
+  auto p = clip.get<double>("p");
+  auto q = clip.get<double>("q");
+  auto seed = clip.get<uint64_t>("seed");
+  auto where = clip.get<boost::json::object>("where");
+  auto overwrite = clip.get<bool>("overwrite");
+
+  metalldata::metall_graph::where_clause where_c;
+  if (where.contains("rule")) {
+    where_c = metalldata::metall_graph::where_clause(where["rule"]);
+  }
+
+  metalldata::metall_graph mg(comm, path, false);
+
+  auto result = mg.random_walks(num_walks, walk_len, p, q, seed, where_c,
+                                output_path, overwrite);
+
+  if (!result) {
+    comm.cerr0() << "Error: " << result.error() << std::endl;
+    return 1;
+  }
+
+  for (const auto& [msg, count] : result.warnings()) {
+    comm.cerr0() << "Warning: " << msg << " (occurred " << count << " times)"
+                 << std::endl;
+  }
+
+  auto rows_written = std::any_cast<size_t>(result.value().at("rows_written"));
+
+  std::map<std::string, size_t> return_dict;
+  return_dict["rows_written"] = ygm::sum(rows_written, comm);
+  clip.to_return(return_dict);
+
+  return 0;
+} catch (const std::runtime_error& e) {
+  std::cerr << "Error in execution: " << e.what() << "; aborting.\n";
+} catch (...) {
+  std::cerr << "Unknown error in execution; aborting.\n";
+}
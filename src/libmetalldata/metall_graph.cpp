@@ -13,6 +13,7 @@
 #include <filesystem>
 #include <cassert>
 #include <cstdint>
+#include <format>
 
 #include <ygm/comm.hpp>
 #include <ygm/io/parquet_parser.hpp>
@@ -23,6 +24,7 @@
 
 #include <boost/graph/graph_traits.hpp>
 #include <multiseries/multiseries_record.hpp>
+#include <multiseries/legacy_record_store.hpp>
 #include <ygm/container/set.hpp>
 #include <ygm/container/counting_set.hpp>
 #include "metall/tags.hpp"
@@ -30,6 +32,33 @@
 
 namespace metalldata {
 
+namespace {
+
+/// Name of the persisted basic_record_store::k_layout_version
+constexpr const char* k_record_store_layout_name = "record_store_layout";
+
+/// Rewrites the layout version 0 record store called name, if any, into the
+/// current layout under the same name.
+template <typename Manager, typename RecordStore>
+void migrate_record_store_v0(Manager& manager, const char* name,
+                             typename RecordStore::string_store_type* strings) {
+  using legacy_type =
+    multiseries::legacy::record_store_v0<typename RecordStore::allocator_type>;
+  auto* pold = manager.template find<legacy_type>(name).first;
+  if (!pold) {
+    return;
+  }
+  const std::string tmp_name = std::string(name) + ".migrating";
+  auto*             ptmp = manager.template construct<RecordStore>(
+    tmp_name.c_str())(strings, manager.get_allocator());
+  multiseries::legacy::migrate(*pold, *ptmp);
+  manager.template destroy<legacy_type>(name);
+  manager.template construct<RecordStore>(name)(std::move(*ptmp));
+  manager.template destroy<RecordStore>(tmp_name.c_str());
+}
+
+}  // namespace
+
 metall_graph::metall_graph(ygm::comm& comm, std::string_view path,
                            bool overwrite)
     : m_comm(comm), m_metall_path(path), m_partitioner(m_comm), pthis(this) {
@@ -53,6 +82,8 @@ metall_graph::metall_graph(ygm::comm& comm, std::string_view path,
 
     m_pstring_store = manager.construct<string_store_type>(
       metall::unique_instance)(manager.get_allocator());
+    manager.construct<uint32_t>(k_record_store_layout_name)(
+      record_store_type::k_layout_version);
     m_pnodes = manager.construct<record_store_type>("nodes")(
       m_pstring_store, manager.get_allocator());
     m_pedges = manager.construct<record_store_type>("edges")(
@@ -60,12 +91,22 @@ metall_graph::metall_graph(ygm::comm& comm, std::string_view path,
     m_pnode_to_locator = manager.construct<map_node_to_locator_type>(
       "globalnodeindex")[map_node_to_locator_bucket_count](
       manager.get_allocator());
+    m_padjacency = manager.construct<persistent_csr_type>("adjacency")(
+      manager.get_allocator());
+    m_preverse_adjacency = manager.construct<persistent_csr_type>(
+      "reverse_adjacency")(manager.get_allocator());
+    m_pmaintained = manager.construct<maintained_analytics>(
+      "maintained_analytics")(manager.get_allocator());
+    m_pdegrees =
+      manager.construct<degree_cache>("degree_cache")(manager.get_allocator());
 
     // add the default series for the indices.
     add_series<std::string_view>(series_name::NODE_COL);
     add_series<std::string_view>(series_name::U_COL);
     add_series<std::string_view>(series_name::V_COL);
     add_series<bool>(series_name::DIR_COL);
+    add_series<int64_t>(series_name::U_LOC_COL);
+    add_series<int64_t>(series_name::V_LOC_COL);
 
   } else {  // open existing
     comm.barrier();
@@ -75,21 +116,74 @@ metall_graph::metall_graph(ygm::comm& comm, std::string_view path,
 
     m_pstring_store =
       manager.find<string_store_type>(metall::unique_instance).first;
-    m_pnodes = manager.find<record_store_type>("nodes").first;
-    m_pedges = manager.find<record_store_type>("edges").first;
+
+    // Stores written before the record store layout was versioned are
+    // migrated to the current layout once; newer layouts are rejected below.
+    auto* playout = manager.find<uint32_t>(k_record_store_layout_name).first;
+    if (!playout && m_pstring_store) {
+      migrate_record_store_v0<metall::manager, record_store_type>(
+        manager, "nodes", m_pstring_store);
+      migrate_record_store_v0<metall::manager, record_store_type>(
+        manager, "edges", m_pstring_store);
+      playout = manager.construct<uint32_t>(k_record_store_layout_name)(
+        record_store_type::k_layout_version);
+    }
+    bool layout_ok =
+      playout && *playout == record_store_type::k_layout_version;
+    std::string open_error =
+      "Failed to find required data structures in metall store";
+    if (playout && !layout_ok) {
+      open_error = std::format(
+        "metall store has record store layout version {}, expected {}",
+        *playout, record_store_type::k_layout_version);
+    }
+
+    m_pnodes = layout_ok ? manager.find<record_store_type>("nodes").first
+                         : nullptr;
+    m_pedges = layout_ok ? manager.find<record_store_type>("edges").first
+                         : nullptr;
     auto gni_ret = manager.find<map_node_to_locator_type>("globalnodeindex");
     m_pnode_to_locator = gni_ret.first;
     YGM_ASSERT_RELEASE(gni_ret.second == map_node_to_locator_bucket_count);
 
+    // Stores created before the adjacency index existed get an empty (stale)
+    // one; it is built on first use.
+    m_padjacency = manager.find<persistent_csr_type>("adjacency").first;
+    if (!m_padjacency) {
+      m_padjacency = manager.construct<persistent_csr_type>("adjacency")(
+        manager.get_allocator());
+    }
+    m_preverse_adjacency =
+      manager.find<persistent_csr_type>("reverse_adjacency").first;
+    if (!m_preverse_adjacency) {
+      m_preverse_adjacency = manager.construct<persistent_csr_type>(
+        "reverse_adjacency")(manager.get_allocator());
+    }
+    m_pmaintained =
+      manager.find<maintained_analytics>("maintained_analytics").first;
+    if (!m_pmaintained) {
+      m_pmaintained = manager.construct<maintained_analytics>(
+        "maintained_analytics")(manager.get_allocator());
+    }
+    m_pdegrees = manager.find<degree_cache>("degree_cache").first;
+    if (!m_pdegrees) {
+      m_pdegrees = manager.construct<degree_cache>("degree_cache")(
+        manager.get_allocator());
+    }
+
     if (!m_pnodes || !m_pedges) {
-      m_comm.cerr0(
-        "Error: Failed to find required data structures in metall store");
+      m_comm.cerr0("Error: " + open_error);
       delete m_pmetall_mpi;
       m_pmetall_mpi = nullptr;
       m_pstring_store = nullptr;
       m_pnodes = nullptr;
       m_pedges = nullptr;
       m_pnode_to_locator = nullptr;
+      m_padjacency = nullptr;
+      m_preverse_adjacency = nullptr;
+      m_pmaintained = nullptr;
+      m_pdegrees = nullptr;
+      throw std::runtime_error(open_error);
     }
   }
 
@@ -99,23 +193,44 @@ metall_graph::metall_graph(ygm::comm& comm, std::string_view path,
   YGM_ASSERT_RELEASE(has_series(series_name::V_COL));
   YGM_ASSERT_RELEASE(has_series(series_name::DIR_COL));
 
+  // Stores created before endpoint locators were persisted get them filled in
+  // from the edge labels once.
+  bool backfill_locators = !has_series(series_name::U_LOC_COL) ||
+                           !has_series(series_name::V_LOC_COL);
+  if (backfill_locators) {
+    add_series<int64_t>(series_name::U_LOC_COL);
+    add_series<int64_t>(series_name::V_LOC_COL);
+  }
+
   //
   // Find required column names
   auto u_col_idx_o = m_pedges->find_series(series_name::U_COL.unqualified());
   auto v_col_idx_o = m_pedges->find_series(series_name::V_COL.unqualified());
   auto dir_col_idx_o =
     m_pedges->find_series(series_name::DIR_COL.unqualified());
+  auto u_loc_col_idx_o =
+    m_pedges->find_series(series_name::U_LOC_COL.unqualified());
+  auto v_loc_col_idx_o =
+    m_pedges->find_series(series_name::V_LOC_COL.unqualified());
   auto node_col_idx_o =
     m_pnodes->find_series(series_name::NODE_COL.unqualified());
   YGM_ASSERT_RELEASE(u_col_idx_o.has_value());
   YGM_ASSERT_RELEASE(v_col_idx_o.has_value());
   YGM_ASSERT_RELEASE(dir_col_idx_o.has_value());
+  YGM_ASSERT_RELEASE(u_loc_col_idx_o.has_value());
+  YGM_ASSERT_RELEASE(v_loc_col_idx_o.has_value());
   YGM_ASSERT_RELEASE(node_col_idx_o.has_value());
 
   m_u_col_idx = edge_series_idx_type{u_col_idx_o.value()};
   m_v_col_idx = edge_series_idx_type{v_col_idx_o.value()};
   m_dir_col_idx = edge_series_idx_type{dir_col_idx_o.value()};
+  m_u_loc_col_idx = edge_series_idx_type{u_loc_col_idx_o.value()};
+  m_v_loc_col_idx = edge_series_idx_type{v_loc_col_idx_o.value()};
   m_node_col_idx = node_series_idx_type{node_col_idx_o.value()};
+
+  if (backfill_locators) {
+    priv_fill_edge_locators(local_edge_idx_type{0});
+  }
 }
 
 metall_graph::~metall_graph() {
@@ -127,6 +242,10 @@ metall_graph::~metall_graph() {
   m_pnodes = nullptr;
   m_pedges = nullptr;
   m_pnode_to_locator = nullptr;
+  m_padjacency = nullptr;
+  m_preverse_adjacency = nullptr;
+  m_pmaintained = nullptr;
+  m_pdegrees = nullptr;
 
   // Destroy the metall manager
   delete m_pmetall_mpi;
@@ -0,0 +1,250 @@
+// Copyright Lawrence Livermore National Security, LLC and other MetallData
+// Project Developers. See the top-level COPYRIGHT file for details.
+//
+// SPDX-License-Identifier: MIT
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <format>
+#include <limits>
+#include <map>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <ygm/comm.hpp>
+#include <ygm/detail/collective.hpp>
+
+#include <metalldata/metall_graph.hpp>
+#include <boost/unordered/unordered_flat_map.hpp>
+#include "ygm/utility/assert.hpp"
+
+namespace metalldata {
+
+namespace {
+
+/// Running aggregate of the edge values reduced onto one node.  Integer and
+/// floating point values are kept apart so int64_t sums stay exact.
+struct node_partial {
+  int64_t count = 0;
+  int64_t isum = 0;
+  int64_t imin = std::numeric_limits<int64_t>::max();
+  int64_t imax = std::numeric_limits<int64_t>::min();
+  double  dsum = 0.0;
+  double  dmin = std::numeric_limits<double>::infinity();
+  double  dmax = -std::numeric_limits<double>::infinity();
+
+  void add(const node_partial& other) {
+    count += other.count;
+    isum += other.isum;
+    imin = std::min(imin, other.imin);
+    imax = std::max(imax, other.imax);
+    dsum += other.dsum;
+    dmin = std::min(dmin, other.dmin);
+    dmax = std::max(dmax, other.dmax);
+  }
+};
+
+}  // namespace
+
+/**
+ * Every rank reduces the values of its own edges per endpoint locator, then
+ * sends one message per remote node to its owner, which merges them.
+ */
+result<> metall_graph::aggregate_to_nodes(const series_name& edge_name,
+                                          std::string_view   agg,
+                                          std::string_view   direction,
+                                          const series_name& out_name,
+                                          const where_clause& where) {
+  if (!out_name.is_node_series()) {
+    return std::unexpected(
+      std::format("invalid series name: {}", out_name.qualified()));
+  }
+
+  if (m_pnodes->contains_series(out_name.unqualified())) {
+    return std::unexpected(
+      std::format("series {} already exists", out_name.qualified()));
+  }
+
+  if (agg != "sum" && agg != "mean" && agg != "min" && agg != "max" &&
+      agg != "count") {
+    return std::unexpected(
+      std::format("unknown aggregation {}", std::string(agg)));
+  }
+
+  bool to_u = direction == "out" || direction == "both";
+  bool to_v = direction == "in" || direction == "both";
+  if (!to_u && !to_v) {
+    return std::unexpected(
+      std::format("direction must be out, in or both, got {}",
+                  std::string(direction)));
+  }
+
+  if (!edge_name.is_edge_series()) {
+    return std::unexpected(
+      std::format("invalid edge series name: {}", edge_name.qualified()));
+  }
+  auto eid_o = pl_find_edge_series(edge_name);
+  if (!eid_o.has_value()) {
+    return std::unexpected(
+      std::format("series {} not found", edge_name.qualified()));
+  }
+  auto sid = eid_o.value();
+  bool is_double = priv_is_edge_series_type<double>(sid);
+  if (agg != "count" && !is_double &&
+      !priv_is_edge_series_type<int64_t>(sid)) {
+    return std::unexpected(std::format("series {} must be double or int64",
+                                       edge_name.qualified()));
+  }
+
+  //
+  // Local combining by endpoint.  Undirected edges reach both endpoints
+  // whatever the direction, as in the forward adjacency.
+  boost::unordered_flat_map<node_locator, node_partial> combined;
+  auto combine = [&](local_edge_idx_type eid, const node_partial& one) {
+    auto [u, v] = pl_get_edge_uv_locators(eid);
+    bool directed = pl_edge_is_directed(eid);
+    if (to_u || !directed) {
+      combined[u].add(one);
+    }
+    if ((to_v || !directed) && v != u) {
+      combined[v].add(one);
+    }
+  };
+
+  if (agg != "count" && where.empty()) {
+    // Unfiltered: read the values chunk by chunk instead of per cell.
+    auto scan = [&]<typename T>() {
+      m_pedges->for_each_chunk<T>(
+        std::to_underlying(sid),
+        [&](std::span<const T> vals, std::span<const uint64_t> validity,
+            size_t base) {
+          for (size_t w = 0; w < validity.size(); ++w) {
+            for (uint64_t word = validity[w]; word != 0; word &= word - 1) {
+              size_t       j = w * 64 + std::countr_zero(word);
+              node_partial one;
+              one.count = 1;
+              if constexpr (std::is_same_v<T, double>) {
+                one.dsum = one.dmin = one.dmax = vals[j];
+              } else {
+                one.isum = one.imin = one.imax = vals[j];
+              }
+              combine(local_edge_idx_type{base + j}, one);
+            }
+          }
+        });
+    };
+    if (is_double) {
+      scan.template operator()<double>();
+    } else {
+      scan.template operator()<int64_t>();
+    }
+  } else {
+    priv_for_all_edges(
+      [&](local_edge_idx_type eid) {
+        node_partial one;
+        one.count = 1;
+        if (is_double) {
+          auto val_o = pl_get_edge_field<double>(sid, eid);
+          if (!val_o.has_value()) {
+            return;
+          }
+          one.dsum = one.dmin = one.dmax = val_o.value();
+        } else if (agg == "count") {
+          if (!m_pedges->get_dynamic(std::to_underlying(sid),
+                                     std::to_underlying(eid))
+                 .has_value()) {
+            return;
+          }
+        } else {
+          auto val_o = pl_get_edge_field<int64_t>(sid, eid);
+          if (!val_o.has_value()) {
+            return;
+          }
+          one.isum = one.imin = one.imax = val_o.value();
+        }
+        combine(eid, one);
+      },
+      where);
+  }
+
+  std::vector<node_partial>         partials(pl_num_node_slots());
+  static std::vector<node_partial>* sp_partials = nullptr;
+  sp_partials = &partials;
+  m_comm.barrier();
+
+  for (const auto& [n, p] : combined) {
+    if (is_local(n)) {
+      partials[std::to_underlying(local(n))].add(p);
+    } else {
+      m_comm.async(
+        owner(n),
+        [](local_node_idx_type nid, int64_t count, int64_t isum, int64_t imin,
+           int64_t imax, double dsum, double dmin, double dmax) {
+          (*sp_partials)[std::to_underlying(nid)].add(
+            {count, isum, imin, imax, dsum, dmin, dmax});
+        },
+        local(n), p.count, p.isum, p.imin, p.imax, p.dsum, p.dmin, p.dmax);
+    }
+  }
+  m_comm.barrier();
+  sp_partials = nullptr;
+  combined.clear();
+
+  //
+  // Nodes without values get no entry, except for count.
+  if (agg == "count") {
+    std::map<local_node_idx_type, int64_t> local_out;
+    priv_for_all_nodes(
+      [&](local_node_idx_type nid) {
+        local_out[nid] = partials[std::to_underlying(nid)].count;
+      },
+      where);
+    return priv_set_node_column_by_idx(out_name, local_out);
+  }
+
+  if (is_double || agg == "mean") {
+    std::map<local_node_idx_type, double> local_out;
+    priv_for_all_nodes(
+      [&](local_node_idx_type nid) {
+        const auto& p = partials[std::to_underlying(nid)];
+        if (p.count == 0) {
+          return;
+        }
+        double sum = is_double ? p.dsum : double(p.isum);
+        if (agg == "mean") {
+          local_out[nid] = sum / double(p.count);
+        } else if (agg == "sum") {
+          local_out[nid] = sum;
+        } else if (agg == "min") {
+          local_out[nid] = p.dmin;
+        } else {
+          local_out[nid] = p.dmax;
+        }
+      },
+      where);
+    return priv_set_node_column_by_idx(out_name, local_out);
+  }
+
+  std::map<local_node_idx_type, int64_t> local_out;
+  priv_for_all_nodes(
+    [&](local_node_idx_type nid) {
+      const auto& p = partials[std::to_underlying(nid)];
+      if (p.count == 0) {
+        return;
+      }
+      if (agg == "sum") {
+        local_out[nid] = p.isum;
+      } else if (agg == "min") {
+        local_out[nid] = p.imin;
+      } else {
+        local_out[nid] = p.imax;
+      }
+    },
+    where);
+  return priv_set_node_column_by_idx(out_name, local_out);
+}
+
+}  // namespace metalldata
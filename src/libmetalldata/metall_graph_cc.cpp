@@ -15,7 +15,7 @@
 #include <cstdint>
 
 #include <ygm/comm.hpp>
-#include <ygm/io/parquet_parser.hpp>
+#include <ygm/detail/collective.hpp>
 
 #include <metalldata/metall_graph.hpp>
 #include <fcntl.h>
@@ -29,6 +29,158 @@
 
 namespace metalldata {
 
+namespace {
+
+size_t uf_find(std::vector<size_t>& parent, size_t x) {
+  while (parent[x] != x) {
+    parent[x] = parent[parent[x]];  // path halving
+    x = parent[x];
+  }
+  return x;
+}
+
+void uf_union(std::vector<size_t>& parent, size_t a, size_t b) {
+  a = uf_find(parent, a);
+  b = uf_find(parent, b);
+  if (a < b) {
+    parent[b] = a;
+  } else if (b < a) {
+    parent[a] = b;
+  }
+}
+
+}  // namespace
+
+void metall_graph::priv_fastsv(
+  std::vector<node_locator>&                                       parent,
+  const std::vector<std::pair<local_node_idx_type, node_locator>>& edges) {
+  //
+  // Each round hooks along edges using grandparents (stochastic and aggressive
+  // hooking), shortcuts, and stops once no grandparent changes.  Labels only
+  // decrease, so each component converges to its smallest node locator.
+  std::vector<node_locator> gp(parent.size());
+
+  std::unordered_map<node_locator, node_locator>         remote_gp;
+  static std::vector<node_locator>*                      sp_parent = nullptr;
+  static std::unordered_map<node_locator, node_locator>* sp_remote_gp = nullptr;
+  sp_parent = &parent;
+  sp_remote_gp = &remote_gp;
+  m_comm.barrier();
+
+  // Refreshes gp from parent; returns true if any grandparent changed.
+  auto update_grandparents = [&]() {
+    remote_gp.clear();
+    for (auto p : parent) {
+      if (!is_local(p)) {
+        remote_gp.try_emplace(p, p);
+      }
+    }
+    for (const auto& [p, unused] : remote_gp) {
+      m_comm.async(
+        owner(p),
+        [](ygm_ptr_type pthis, local_node_idx_type pid, int requesting_rank) {
+          auto ploc = make_node_locator(pthis->m_comm.rank(), pid);
+          pthis->m_comm.async(
+            requesting_rank,
+            [](node_locator p, node_locator gpl) { (*sp_remote_gp)[p] = gpl; },
+            ploc, (*sp_parent)[std::to_underlying(pid)]);
+        },
+        pthis, local(p), m_comm.rank());
+    }
+    m_comm.barrier();
+
+    bool changed = false;
+    for (size_t i = 0; i < parent.size(); ++i) {
+      auto p = parent[i];
+      auto g =
+        is_local(p) ? parent[std::to_underlying(local(p))] : remote_gp.at(p);
+      if (g != gp[i]) {
+        gp[i] = g;
+        changed = true;
+      }
+    }
+    return changed;
+  };
+
+  // Offers label to node vid and to its parent.
+  auto hook = [](ygm_ptr_type pthis, local_node_idx_type vid,
+                 node_locator label) {
+    auto& fv = (*sp_parent)[std::to_underlying(vid)];
+    auto  vparent = fv;
+    if (label < fv) {
+      fv = label;
+    }
+    if (owner(vparent) == pthis->m_comm.rank()) {
+      auto& fp = (*sp_parent)[std::to_underlying(local(vparent))];
+      if (label < fp) {
+        fp = label;
+      }
+    } else {
+      pthis->m_comm.async(
+        owner(vparent),
+        [](local_node_idx_type pid, node_locator l) {
+          auto& fp = (*sp_parent)[std::to_underlying(pid)];
+          if (l < fp) {
+            fp = l;
+          }
+        },
+        local(vparent), label);
+    }
+  };
+
+  update_grandparents();
+  bool changed = true;
+  while (changed) {
+    for (const auto& [uid, v] : edges) {
+      auto label = gp[std::to_underlying(uid)];
+      if (is_local(v)) {
+        hook(pthis, local(v), label);
+      } else {
+        m_comm.async(owner(v), hook, pthis, local(v), label);
+      }
+    }
+    m_comm.barrier();
+    for (size_t i = 0; i < parent.size(); ++i) {
+      if (gp[i] < parent[i]) {
+        parent[i] = gp[i];
+      }
+    }
+    changed = ygm::logical_or(update_grandparents(), m_comm);
+  }
+  sp_parent = nullptr;
+  sp_remote_gp = nullptr;
+
+  parent = std::move(gp);
+}
+
+std::map<metall_graph::node_locator, std::string>
+metall_graph::priv_gather_node_labels(
+  const std::set<metall_graph::node_locator>& locators) {
+  //
+  // Ask the owner of each locator for its label
+  std::map<node_locator, std::string>         labels;
+  static std::map<node_locator, std::string>* sp_labels = nullptr;
+  sp_labels = &labels;
+  static metall_graph* spthis = nullptr;
+  spthis = this;
+  m_comm.barrier();
+  for (const auto& loc : locators) {
+    auto move_label = [loc](int requesting_rank) {
+      std::string label(spthis->pl_get_node_label(local(loc)));
+      auto        response = [loc](const std::string label) {
+        (*sp_labels)[loc] = label;
+      };
+      spthis->m_comm.async(requesting_rank, response, label);
+    };
+    m_comm.async(owner(loc), move_label, m_comm.rank());
+  }
+
+  m_comm.barrier();
+
+  sp_labels = nullptr;
+  return labels;
+}
+
 result<> metall_graph::connected_components(const series_name&  out_name,
                                             const where_clause& where) {
   if (!out_name.is_node_series()) {
@@ -41,119 +193,103 @@ result<> metall_graph::connected_components(const series_name&  out_name,
       std::format("Series {} already exists", out_name.qualified()));
   }
 
-  ygm::container::map<node_locator,
-                      std::pair<node_locator, std::vector<node_locator>>>
-    adj_list(m_comm);
-
-  priv_for_all_edges(
-    [&](local_edge_idx_type eid) {
-      auto [u, v] = pl_get_edge_uv_locators(eid);
-      bool is_directed = pl_edge_is_directed(eid);
-      auto adj_inserter =
-        [](const node_locator                                  ccid,
-           std::pair<node_locator, std::vector<node_locator>>& adj,
-           const node_locator&                                 vert) {
-          adj.second.push_back(vert);
-          adj.first = ccid;
-        };
-      adj_list.async_visit(u, adj_inserter, v);
-      adj_list.async_visit(v, adj_inserter, u);
-    },
-    where);
+  csr_type scratch;
+  csr_view adj = priv_adjacency(where, scratch);
+
+  //
+  // Every node starts in its own component.  cc[nid] holds the smallest node
+  // locator seen so far; active marks nodes that take part in the computation.
+  std::vector<node_locator> cc(pl_num_node_slots());
+  std::vector<bool>         active(pl_num_node_slots(), false);
+  for (size_t i = 0; i < cc.size(); ++i) {
+    cc[i] = make_node_locator(m_comm.rank(), local_node_idx_type{i});
+    active[i] = adj.degree(local_node_idx_type{i}) > 0;
+  }
   if (where.is_node_clause()) {
     priv_for_all_nodes_nwhere(
-      [&](local_node_idx_type nid) {
-        // Do something with each node
-        auto nloc = make_node_locator(m_comm.rank(), nid);
-        adj_list.async_visit(
-          nloc, [](const node_locator&                                 ccid,
-                   std::pair<node_locator, std::vector<node_locator>>& adj) {
-            adj.first = ccid;
-          });
-      },
+      [&](local_node_idx_type nid) { active[std::to_underlying(nid)] = true; },
       where);
   }
 
-  static auto* sp_adj_list = &adj_list;
+  //
+  // Local union-find over edges with both endpoints on this rank.  Roots are
+  // the smallest local id of their set.  Edges that cross ranks are kept,
+  // stored at both endpoints, for the distributed phase.
+  std::vector<size_t> uf(cc.size());
+  for (size_t i = 0; i < uf.size(); ++i) {
+    uf[i] = i;
+  }
+
+  using cross_edge = std::pair<local_node_idx_type, node_locator>;
+  std::vector<cross_edge>         edges;
+  static std::vector<cross_edge>* sp_edges = nullptr;
+  static std::vector<bool>*       sp_active = nullptr;
+  sp_edges = &edges;
+  sp_active = &active;
   m_comm.barrier();
 
-  struct cc_visitor {
-    void operator()(const node_locator&                                 v,
-                    std::pair<node_locator, std::vector<node_locator>>& adj,
-                    const node_locator&                                 cc_id) {
-      if (cc_id < adj.first) {
-        adj.first = cc_id;
-        for (const auto& n : adj.second) {
-          sp_adj_list->async_visit(n, cc_visitor{}, cc_id);
-        }
-      }
-    }
+  // Edge targets take part too, e.g., the sinks of directed edges.
+  auto stage = [](local_node_idx_type nid, node_locator nbr) {
+    sp_edges->emplace_back(nid, nbr);
+    (*sp_active)[std::to_underlying(nid)] = true;
   };
 
-  adj_list.for_all(
-    [&](const node_locator&                                 v,
-        std::pair<node_locator, std::vector<node_locator>>& adj) {
-      auto min_id = v;
-      for (const auto& n : adj.second) {
-        min_id = std::min(min_id, n);
+  for (size_t i = 0; i < adj.num_rows(); ++i) {
+    local_node_idx_type uid{i};
+    auto                uloc = make_node_locator(m_comm.rank(), uid);
+    for (auto v : adj.neighbors(uid)) {
+      if (is_local(v)) {
+        uf_union(uf, i, std::to_underlying(local(v)));
+        active[std::to_underlying(local(v))] = true;
+      } else {
+        edges.emplace_back(uid, v);
+        m_comm.async(owner(v), stage, local(v), uloc);
       }
-
-      if (min_id == v) {
-        for (const auto& n : adj.second) {
-          sp_adj_list->async_visit(n, cc_visitor{}, adj.first);
-        }
-      }
-    });
+    }
+  }
   m_comm.barrier();
+  sp_edges = nullptr;
+  sp_active = nullptr;
+  // A filtered adjacency is no longer needed past this point.
+  scratch.clear();
 
   //
-  // Gather the connected component locators needed by this rank
-  std::set<node_locator> cc_locators_i_need;
-  adj_list.for_all(
-    [&](const node_locator&                                 v,
-        std::pair<node_locator, std::vector<node_locator>>& adj) {
-      adj.second.clear();
-      adj.second.shrink_to_fit();
-      cc_locators_i_need.insert(adj.first);
-    });
+  // Each local set becomes a star around its root; the star edges carry the
+  // local merges into the distributed phase.
+  for (size_t i = 0; i < uf.size(); ++i) {
+    size_t root = uf_find(uf, i);
+    cc[i] = make_node_locator(m_comm.rank(), local_node_idx_type{root});
+    if (root != i) {
+      local_node_idx_type nid{i};
+      edges.emplace_back(nid, cc[i]);
+      edges.emplace_back(local_node_idx_type{root},
+                         make_node_locator(m_comm.rank(), nid));
+    }
+  }
+  uf.clear();
+  uf.shrink_to_fit();
+
+  priv_fastsv(cc, edges);
 
   //
-  // Convert the connected component locators into string labels
-  std::map<node_locator, std::string>         cc_labels;
-  static std::map<node_locator, std::string>* sp_cc_labels = nullptr;
-  sp_cc_labels = &cc_labels;
-  static metall_graph* spthis = nullptr;
-  spthis = this;
-  m_comm.barrier();
-  for (const auto& ccloc : cc_locators_i_need) {
-    auto move_label = [ccloc](int requesting_rank) {
-      std::string label(spthis->pl_get_node_label(local(ccloc)));
-      auto        response = [ccloc](const std::string label) {
-        (*sp_cc_labels)[ccloc] = label;
-      };
-      spthis->m_comm.async(requesting_rank, response, label);
-    };
-    m_comm.async(owner(ccloc), move_label, m_comm.rank());
+  // Gather the connected component locators needed by this rank
+  std::set<node_locator> cc_locators_i_need;
+  for (size_t i = 0; i < cc.size(); ++i) {
+    if (active[i]) {
+      cc_locators_i_need.insert(cc[i]);
+    }
   }
 
+  auto cc_labels = priv_gather_node_labels(cc_locators_i_need);
+
   //
   // Build final cc map from local node id to connected component label
-  std::map<local_node_idx_type, std::string>         local_cc_map;
-  static std::map<local_node_idx_type, std::string>* sp_local_cc_map = nullptr;
-  sp_local_cc_map = &local_cc_map;
-  m_comm.barrier();
-  adj_list.for_all(
-    [&](const node_locator&                                 v,
-        std::pair<node_locator, std::vector<node_locator>>& adj) {
-      std::string cc_label = cc_labels.at(adj.first);
-      m_comm.async(
-        owner(v),
-        [](local_node_idx_type nid, std::string cc_label) {
-          (*sp_local_cc_map)[nid] = cc_label;
-        },
-        local(v), cc_label);
-    });
-  m_comm.barrier();
+  std::map<local_node_idx_type, std::string> local_cc_map;
+  for (size_t i = 0; i < cc.size(); ++i) {
+    if (active[i]) {
+      local_cc_map[local_node_idx_type{i}] = cc_labels.at(cc[i]);
+    }
+  }
 
   // // no warnings possible here, so just return the result directly.
   return priv_set_node_column_by_idx(out_name, local_cc_map);
@@ -0,0 +1,377 @@
+// Copyright Lawrence Livermore National Security, LLC and other MetallData
+// Project Developers. See the top-level COPYRIGHT file for details.
+//
+// SPDX-License-Identifier: MIT
+
+#include <algorithm>
+#include <format>
+#include <map>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include <ygm/comm.hpp>
+#include <ygm/detail/collective.hpp>
+
+#include <metalldata/metall_graph.hpp>
+#include <boost/container_hash/hash.hpp>
+#include <boost/unordered/unordered_flat_map.hpp>
+#include "ygm/utility/assert.hpp"
+
+namespace metalldata {
+
+namespace {
+
+enum class agg_op { count, sum, min, max, first };
+
+std::optional<agg_op> parse_agg_op(std::string_view op) {
+  if (op == "count") return agg_op::count;
+  if (op == "sum") return agg_op::sum;
+  if (op == "min") return agg_op::min;
+  if (op == "max") return agg_op::max;
+  if (op == "first") return agg_op::first;
+  return std::nullopt;
+}
+
+/// A resolved aggregation: input/output series indices and the numeric type.
+struct agg_info {
+  agg_op op;
+  size_t in_idx;
+  size_t out_idx;
+  bool   is_double;
+};
+
+/// Partial aggregate of a group of parallel edges.  Numeric aggregations keep
+/// their value in ivals or dvals, by type; has marks slots with a value.
+struct partial {
+  size_t               count = 0;
+  std::vector<int64_t> ivals;
+  std::vector<double>  dvals;
+  std::vector<uint8_t> has;
+};
+
+void merge_partial(partial& into, size_t count,
+                   const std::vector<int64_t>& ivals,
+                   const std::vector<double>&  dvals,
+                   const std::vector<uint8_t>& has,
+                   const std::vector<agg_info>& aggs) {
+  into.count += count;
+  for (size_t k = 0; k < aggs.size(); ++k) {
+    if (!has[k]) {
+      continue;
+    }
+    if (!into.has[k]) {
+      into.ivals[k] = ivals[k];
+      into.dvals[k] = dvals[k];
+      into.has[k] = true;
+      continue;
+    }
+    switch (aggs[k].op) {
+      case agg_op::sum:
+        into.ivals[k] += ivals[k];
+        into.dvals[k] += dvals[k];
+        break;
+      case agg_op::min:
+        into.ivals[k] = std::min(into.ivals[k], ivals[k]);
+        into.dvals[k] = std::min(into.dvals[k], dvals[k]);
+        break;
+      case agg_op::max:
+        into.ivals[k] = std::max(into.ivals[k], ivals[k]);
+        into.dvals[k] = std::max(into.dvals[k], dvals[k]);
+        break;
+      default:
+        break;
+    }
+  }
+}
+
+}  // namespace
+
+/**
+ * Parallel edges are grouped by (u, v, directed), with undirected endpoints
+ * ordered.  Every rank first folds its own parallel edges into the one with
+ * the smallest id, then ships one partial aggregate per group to the owner of
+ * u.  The owner merges the partials, picks the smallest edge locator as the
+ * survivor, sends it the final aggregate, and tells the other ranks' survivors
+ * to remove themselves.
+ */
+result<std::map<std::string, size_t>> metall_graph::collapse_edges(
+  const std::vector<edge_aggregation>& aggs, const where_clause& where) {
+  result<std::map<std::string, size_t>> to_return;
+
+  //
+  // Resolve and validate every aggregation before creating any output
+  // series, so that a bad request leaves the edge store untouched.
+  std::vector<agg_info> infos;
+  std::vector<bool>     in_place(aggs.size(), false);
+  for (size_t i = 0; i < aggs.size(); ++i) {
+    const auto& agg = aggs[i];
+    auto        op_o = parse_agg_op(agg.op);
+    if (!op_o.has_value()) {
+      return std::unexpected(std::format("unknown aggregation {}", agg.op));
+    }
+    auto op = op_o.value();
+    if (!agg.out.is_edge_series() || agg.out.is_reserved()) {
+      return std::unexpected(
+        std::format("invalid series name: {}", agg.out.qualified()));
+    }
+
+    agg_info info{op, 0, 0, false};
+    if (op != agg_op::count) {
+      auto in_o = pl_find_edge_series(agg.in);
+      if (!agg.in.is_edge_series() || !in_o.has_value()) {
+        return std::unexpected(
+          std::format("series {} not found", agg.in.qualified()));
+      }
+      info.in_idx = std::to_underlying(in_o.value());
+      info.is_double = priv_is_edge_series_type<double>(in_o.value());
+      if (op != agg_op::first && !info.is_double &&
+          !priv_is_edge_series_type<int64_t>(in_o.value())) {
+        return std::unexpected(std::format("series {} must be double or int64",
+                                           agg.in.qualified()));
+      }
+    }
+
+    // Aggregating a series into itself is allowed, except for count.
+    in_place[i] = op != agg_op::count && agg.out == agg.in;
+    if (has_series(agg.out) && !in_place[i]) {
+      return std::unexpected(
+        std::format("series {} already exists", agg.out.qualified()));
+    }
+    // No output may be written twice.  first reads its input when the
+    // survivor is written, so its input must not be aggregated in place.
+    for (size_t j = 0; j < aggs.size(); ++j) {
+      if (j == i) {
+        continue;
+      }
+      if (aggs[j].out == agg.out ||
+          (aggs[j].op == "first" && aggs[j].in == agg.out)) {
+        return std::unexpected(std::format(
+          "series {} is used by more than one aggregation",
+          agg.out.qualified()));
+      }
+    }
+    infos.push_back(info);
+  }
+
+  for (size_t i = 0; i < aggs.size(); ++i) {
+    auto& info = infos[i];
+    auto  out = aggs[i].out.unqualified();
+    if (in_place[i]) {
+      info.out_idx = info.in_idx;
+    } else if (info.op == agg_op::count) {
+      info.out_idx = m_pedges->add_series<int64_t>(out);
+    } else if (info.op != agg_op::first) {
+      info.out_idx = info.is_double ? m_pedges->add_series<double>(out)
+                                    : m_pedges->add_series<int64_t>(out);
+    } else {
+      auto in_idx = edge_series_idx_type{info.in_idx};
+      if (priv_is_edge_series_type<bool>(in_idx)) {
+        info.out_idx = m_pedges->add_series<bool>(out);
+      } else if (priv_is_edge_series_type<int64_t>(in_idx)) {
+        info.out_idx = m_pedges->add_series<int64_t>(out);
+      } else if (info.is_double) {
+        info.out_idx = m_pedges->add_series<double>(out);
+      } else {
+        info.out_idx = m_pedges->add_series<std::string_view>(out);
+      }
+    }
+  }
+
+  using key_type = std::tuple<node_locator, node_locator, bool>;
+  struct key_hash {
+    size_t operator()(const key_type& k) const {
+      size_t seed = 0;
+      boost::hash_combine(seed, std::to_underlying(std::get<0>(k)));
+      boost::hash_combine(seed, std::to_underlying(std::get<1>(k)));
+      boost::hash_combine(seed, std::get<2>(k));
+      return seed;
+    }
+  };
+
+  //
+  // Local pre-aggregation: the first local edge of a group represents it,
+  // the others are removed.
+  boost::unordered_flat_map<key_type, std::pair<local_edge_idx_type, partial>,
+                            key_hash>
+                                   local_groups;
+  std::vector<local_edge_idx_type> removed;
+  partial                          single;
+  single.ivals.resize(infos.size());
+  single.dvals.resize(infos.size());
+  single.has.resize(infos.size());
+  priv_for_all_edges(
+    [&](local_edge_idx_type eid) {
+      auto [u, v] = pl_get_edge_uv_locators(eid);
+      bool directed = pl_edge_is_directed(eid);
+      if (!directed && v < u) {
+        std::swap(u, v);
+      }
+
+      single.count = 1;
+      for (size_t k = 0; k < infos.size(); ++k) {
+        single.has[k] = false;
+        const auto& info = infos[k];
+        if (info.op == agg_op::count || info.op == agg_op::first) {
+          continue;
+        }
+        if (info.is_double) {
+          auto val_o = pl_get_edge_field<double>(
+            edge_series_idx_type{info.in_idx}, eid);
+          if (val_o.has_value()) {
+            single.dvals[k] = val_o.value();
+            single.has[k] = true;
+          }
+        } else {
+          auto val_o = pl_get_edge_field<int64_t>(
+            edge_series_idx_type{info.in_idx}, eid);
+          if (val_o.has_value()) {
+            single.ivals[k] = val_o.value();
+            single.has[k] = true;
+          }
+        }
+      }
+
+      auto [it, inserted] =
+        local_groups.try_emplace(key_type{u, v, directed}, eid, single);
+      if (!inserted) {
+        merge_partial(it->second.second, single.count, single.ivals,
+                      single.dvals, single.has, infos);
+        removed.push_back(eid);
+      }
+    },
+    where);
+
+  //
+  // Shuffle the partials to the owner of u.
+  struct owner_group {
+    edge_locator              survivor;
+    std::vector<edge_locator> losers;
+    partial                   agg;
+  };
+  boost::unordered_flat_map<key_type, owner_group, key_hash> groups;
+  static boost::unordered_flat_map<key_type, owner_group, key_hash>*
+                                sp_groups = nullptr;
+  static std::vector<agg_info>* sp_infos = nullptr;
+  sp_groups = &groups;
+  sp_infos = &infos;
+  m_comm.barrier();
+
+  auto merge = [](node_locator u, node_locator v, bool directed,
+                  edge_locator rep, size_t count,
+                  const std::vector<int64_t>& ivals,
+                  const std::vector<double>&  dvals,
+                  const std::vector<uint8_t>& has) {
+    auto [it, inserted] =
+      sp_groups->try_emplace(key_type{u, v, directed}, owner_group{});
+    auto& g = it->second;
+    if (inserted) {
+      g.survivor = rep;
+      g.agg.ivals.resize(sp_infos->size());
+      g.agg.dvals.resize(sp_infos->size());
+      g.agg.has.resize(sp_infos->size());
+    } else if (rep < g.survivor) {
+      g.losers.push_back(g.survivor);
+      g.survivor = rep;
+    } else {
+      g.losers.push_back(rep);
+    }
+    merge_partial(g.agg, count, ivals, dvals, has, *sp_infos);
+  };
+
+  for (const auto& [key, rep_partial] : local_groups) {
+    const auto& [u, v, directed] = key;
+    const auto& [eid, p] = rep_partial;
+    auto rep = make_edge_locator(m_comm.rank(), eid);
+    if (owner(u) == m_comm.rank()) {
+      merge(u, v, directed, rep, p.count, p.ivals, p.dvals, p.has);
+    } else {
+      m_comm.async(owner(u), merge, u, v, directed, rep, p.count, p.ivals,
+                   p.dvals, p.has);
+    }
+  }
+  m_comm.barrier();
+  local_groups.clear();
+
+  //
+  // Write the final aggregates to the survivors and remove the losers.
+  auto finalize = [](ygm_ptr_type pthis, local_edge_idx_type eid, size_t count,
+                     const std::vector<int64_t>& ivals,
+                     const std::vector<double>&  dvals,
+                     const std::vector<uint8_t>& has) {
+    auto& store = *pthis->m_pedges;
+    auto  rid = std::to_underlying(eid);
+    for (size_t k = 0; k < sp_infos->size(); ++k) {
+      const auto& info = (*sp_infos)[k];
+      switch (info.op) {
+        case agg_op::count:
+          store.set(info.out_idx, rid, int64_t(count));
+          break;
+        case agg_op::first:
+          if (info.out_idx != info.in_idx) {
+            auto val_o = store.get_dynamic(info.in_idx, rid);
+            if (val_o.has_value()) {
+              std::visit(
+                [&](const auto& val) {
+                  using T = std::decay_t<decltype(val)>;
+                  if constexpr (!std::is_same_v<T, std::monostate>) {
+                    store.set(info.out_idx, rid, val);
+                  }
+                },
+                val_o.value());
+            }
+          }
+          break;
+        default:
+          if (!has[k]) {
+            store.remove(info.out_idx, rid);
+          } else if (info.is_double) {
+            store.set(info.out_idx, rid, dvals[k]);
+          } else {
+            store.set(info.out_idx, rid, ivals[k]);
+          }
+          break;
+      }
+    }
+  };
+  auto remove = [](ygm_ptr_type pthis, local_edge_idx_type eid) {
+    pthis->m_pedges->remove_record(std::to_underlying(eid));
+  };
+
+  for (const auto& [key, g] : groups) {
+    m_comm.async(owner(g.survivor), finalize, pthis, local(g.survivor),
+                 g.agg.count, g.agg.ivals, g.agg.dvals, g.agg.has);
+    for (auto loser : g.losers) {
+      m_comm.async(owner(loser), remove, pthis, local(loser));
+    }
+  }
+  for (auto eid : removed) {
+    m_pedges->remove_record(std::to_underlying(eid));
+  }
+  m_comm.barrier();
+  size_t num_groups = ygm::sum(groups.size(), m_comm);
+  sp_groups = nullptr;
+  sp_infos = nullptr;
+
+  priv_invalidate_adjacency();
+  // Removals cannot be folded into the maintained union-find; rebuild it.
+  m_pmaintained->invalidate();
+  if (auto rc = priv_refresh_maintained(local_edge_idx_type{0}); !rc) {
+    return std::unexpected(rc.error());
+  }
+
+  size_t num_losers = 0;
+  for (const auto& [key, g] : groups) {
+    num_losers += g.losers.size();
+  }
+  std::map<std::string, size_t> retdict{
+    {"num_groups", num_groups},
+    {"num_edges_removed", ygm::sum(removed.size() + num_losers, m_comm)}};
+  to_return = retdict;
+  return to_return;
+}
+
+}  // namespace metalldata
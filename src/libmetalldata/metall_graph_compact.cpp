@@ -0,0 +1,194 @@
+// Copyright Lawrence Livermore National Security, LLC and other MetallData
+// Project Developers. See the top-level COPYRIGHT file for details.
+//
+// SPDX-License-Identifier: MIT
+
+#include <algorithm>
+#include <map>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <ygm/comm.hpp>
+#include <ygm/detail/collective.hpp>
+
+#include <metalldata/metall_graph.hpp>
+#include <boost/unordered/unordered_flat_map.hpp>
+#include "ygm/utility/assert.hpp"
+
+namespace metalldata {
+
+/**
+ * Edge locators are only held by the adjacency indexes, which are
+ * invalidated.  Node locators are also held by other ranks, so nodes are
+ * compacted, collectively, only if some rank has removed node records.
+ */
+result<std::map<std::string, size_t>> metall_graph::compact() {
+  result<std::map<std::string, size_t>> to_return;
+
+  const size_t bytes_before =
+    m_pedges->storage_bytes() + m_pnodes->storage_bytes();
+  const size_t node_holes =
+    m_pnodes->num_record_slots() - m_pnodes->num_records();
+  const bool compact_nodes = ygm::logical_or(node_holes > 0, m_comm);
+  if (compact_nodes) {
+    priv_compact_nodes();
+  }
+
+  // Node compaction removes the edges of removed nodes, so edges go second.
+  const size_t edge_holes =
+    m_pedges->num_record_slots() - m_pedges->num_records();
+  if (edge_holes > 0) {
+    m_pedges->compact();
+  }
+
+  priv_invalidate_adjacency();
+  if (compact_nodes) {
+    // The maintained analytics are indexed by local node id; rebuild them.
+    m_pmaintained->invalidate();
+    if (auto rc = priv_refresh_maintained(local_edge_idx_type{0}); !rc) {
+      return std::unexpected(rc.error());
+    }
+  }
+
+  const size_t bytes_after =
+    m_pedges->storage_bytes() + m_pnodes->storage_bytes();
+  const size_t reclaimed = bytes_before - std::min(bytes_before, bytes_after);
+
+  std::map<std::string, size_t> retdict{
+    {"bytes_reclaimed", ygm::sum(reclaimed, m_comm)},
+    {"num_edge_slots_removed", ygm::sum(edge_holes, m_comm)},
+    {"num_node_slots_removed", ygm::sum(node_holes, m_comm)}};
+  to_return = retdict;
+  return to_return;
+}
+
+/**
+ * The distinct remote locators held here are requested from their owners in
+ * one message per owner rank, and the owners reply with the new locators of
+ * the surviving nodes.
+ */
+void metall_graph::priv_compact_nodes() {
+  const auto new_ids = m_pnodes->compact();
+
+  std::vector<std::vector<local_node_idx_type>> requests(m_comm.size());
+  {
+    std::vector<node_locator> needed;
+    for (size_t b = 0; b < map_node_to_locator_bucket_count; ++b) {
+      for (const auto& [label, nl] : m_pnode_to_locator[b]) {
+        if (!is_local(nl)) {
+          needed.push_back(nl);
+        }
+      }
+    }
+    priv_for_all_edges([&](local_edge_idx_type eid) {
+      auto [u, v] = pl_get_edge_uv_locators(eid);
+      for (auto nl : {u, v}) {
+        if (!is_local(nl)) {
+          needed.push_back(nl);
+        }
+      }
+    });
+    std::sort(needed.begin(), needed.end());
+    needed.erase(std::unique(needed.begin(), needed.end()), needed.end());
+    for (auto n : needed) {
+      requests[owner(n)].push_back(local(n));
+    }
+  }
+
+  boost::unordered_flat_map<node_locator, node_locator>         remote;
+  static boost::unordered_flat_map<node_locator, node_locator>* sp_remote =
+    nullptr;
+  static const std::vector<record_store_type::record_id_type>* sp_new_ids =
+    nullptr;
+  sp_remote = &remote;
+  sp_new_ids = &new_ids;
+  m_comm.barrier();
+
+  static constexpr auto reply = [](const std::vector<node_locator>& olds,
+                                   const std::vector<node_locator>& news) {
+    for (size_t i = 0; i < olds.size(); ++i) {
+      sp_remote->emplace(olds[i], news[i]);
+    }
+  };
+  auto lookup = [](ygm_ptr_type pthis, int from,
+                   const std::vector<local_node_idx_type>& nids) {
+    std::vector<node_locator> olds;
+    std::vector<node_locator> news;
+    const auto                rank = pthis->m_comm.rank();
+    for (auto nid : nids) {
+      auto old_idx = std::to_underlying(nid);
+      if (old_idx >= sp_new_ids->size() ||
+          (*sp_new_ids)[old_idx] == record_store_type::k_removed_record) {
+        continue;
+      }
+      olds.push_back(make_node_locator(rank, nid));
+      news.push_back(make_node_locator(
+        rank, local_node_idx_type{(*sp_new_ids)[old_idx]}));
+    }
+    pthis->m_comm.async(from, reply, olds, news);
+  };
+  for (size_t dest = 0; dest < requests.size(); ++dest) {
+    if (!requests[dest].empty()) {
+      m_comm.async(dest, lookup, pthis, m_comm.rank(), requests[dest]);
+    }
+  }
+  m_comm.barrier();
+  sp_remote = nullptr;
+  sp_new_ids = nullptr;
+
+  auto remap = [&](node_locator nl) -> std::optional<node_locator> {
+    if (is_local(nl)) {
+      auto old_idx = std::to_underlying(local(nl));
+      if (old_idx >= new_ids.size() ||
+          new_ids[old_idx] == record_store_type::k_removed_record) {
+        return std::nullopt;
+      }
+      return make_node_locator(m_comm.rank(),
+                               local_node_idx_type{new_ids[old_idx]});
+    }
+    auto it = remote.find(nl);
+    if (it == remote.end()) {
+      return std::nullopt;
+    }
+    return it->second;
+  };
+
+  //
+  // Rewrite the label index and the edge locator series.
+  for (size_t b = 0; b < map_node_to_locator_bucket_count; ++b) {
+    auto&                              bank = m_pnode_to_locator[b];
+    std::vector<string_table_accessor> dropped;
+    for (auto& [label, nl] : bank) {
+      auto nl_o = remap(nl);
+      if (nl_o.has_value()) {
+        nl = nl_o.value();
+      } else {
+        dropped.push_back(label);
+      }
+    }
+    for (const auto& label : dropped) {
+      bank.erase(label);
+    }
+  }
+
+  // An edge whose endpoint was removed goes with it, so that every edge
+  // keeps both locators.
+  priv_for_all_edges([&](local_edge_idx_type eid) {
+    auto [u, v] = pl_get_edge_uv_locators(eid);
+    auto u_o = remap(u);
+    auto v_o = remap(v);
+    if (!u_o.has_value() || !v_o.has_value()) {
+      m_pedges->remove_record(std::to_underlying(eid));
+      return;
+    }
+    m_pedges->set(std::to_underlying(m_u_loc_col_idx), std::to_underlying(eid),
+                  static_cast<int64_t>(std::to_underlying(u_o.value())));
+    m_pedges->set(std::to_underlying(m_v_loc_col_idx), std::to_underlying(eid),
+                  static_cast<int64_t>(std::to_underlying(v_o.value())));
+  });
+  m_comm.barrier();
+}
+
+}  // namespace metalldata
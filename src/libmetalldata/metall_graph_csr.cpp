@@ -0,0 +1,220 @@
+// Copyright Lawrence Livermore National Security, LLC and other MetallData
+// Project Developers. See the top-level COPYRIGHT file for details.
+//
+// SPDX-License-Identifier: MIT
+
+#include <metalldata/metall_graph.hpp>
+#include <ygm/utility/assert.hpp>
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace metalldata {
+
+template <typename Csr>
+void metall_graph::priv_build_adjacency(const metall_graph::where_clause& where,
+                                        Csr& csr) const {
+  using entry = typename Csr::entry;
+
+  // Entries are staged on the owner of the row's node.
+  std::vector<entry>         staged;
+  static std::vector<entry>* sp_staged = nullptr;
+  sp_staged = &staged;
+  m_comm.barrier();
+
+  auto stage = [](local_node_idx_type row, node_locator nbr, edge_locator el) {
+    sp_staged->push_back({row, nbr, el});
+  };
+
+  priv_for_all_edges(
+    [&](local_edge_idx_type eid) {
+      auto [u, v] = pl_get_edge_uv_locators(eid);
+      auto el = make_edge_locator(m_comm.rank(), eid);
+      m_comm.async(owner(u), stage, local(u), v, el);
+      if (!pl_edge_is_directed(eid)) {
+        m_comm.async(owner(v), stage, local(v), u, el);
+      }
+    },
+    where);
+  m_comm.barrier();
+
+  csr.build(pl_num_node_slots(), staged);
+  sp_staged = nullptr;
+}
+
+metall_graph::csr_view metall_graph::priv_adjacency(
+  const metall_graph::where_clause& where, metall_graph::csr_type& scratch) {
+  if (!where.empty()) {
+    priv_build_adjacency(where, scratch);
+    return scratch.view();
+  }
+
+  // Staleness is set collectively, so all ranks agree on whether to rebuild.
+  if (!m_padjacency->valid()) {
+    priv_build_adjacency(where, *m_padjacency);
+  }
+  YGM_ASSERT_RELEASE(m_padjacency->view().num_rows() == pl_num_node_slots());
+  return m_padjacency->view();
+}
+
+template <typename Csr>
+void metall_graph::priv_build_reverse_adjacency(metall_graph::csr_view adj,
+                                                Csr& csr) const {
+  using entry = typename Csr::entry;
+
+  std::vector<entry>         staged;
+  static std::vector<entry>* sp_staged = nullptr;
+  sp_staged = &staged;
+  m_comm.barrier();
+
+  auto stage = [](local_node_idx_type row, node_locator nbr, edge_locator el) {
+    sp_staged->push_back({row, nbr, el});
+  };
+
+  for (size_t i = 0; i < adj.num_rows(); ++i) {
+    local_node_idx_type u{i};
+    auto                uloc = make_node_locator(m_comm.rank(), u);
+    auto                nbrs = adj.neighbors(u);
+    auto                edges = adj.edges(u);
+    for (size_t j = 0; j < nbrs.size(); ++j) {
+      m_comm.async(owner(nbrs[j]), stage, local(nbrs[j]), uloc, edges[j]);
+    }
+  }
+  m_comm.barrier();
+
+  csr.build(pl_num_node_slots(), staged);
+  sp_staged = nullptr;
+}
+
+metall_graph::csr_view metall_graph::priv_reverse_adjacency(
+  metall_graph::csr_view adj, metall_graph::csr_type& scratch) const {
+  priv_build_reverse_adjacency(adj, scratch);
+  return scratch.view();
+}
+
+metall_graph::csr_view metall_graph::priv_reverse_adjacency(
+  const metall_graph::where_clause& where, metall_graph::csr_view adj,
+  metall_graph::csr_type& scratch) {
+  if (!where.empty()) {
+    return priv_reverse_adjacency(adj, scratch);
+  }
+
+  if (!m_preverse_adjacency->valid()) {
+    priv_build_reverse_adjacency(adj, *m_preverse_adjacency);
+  }
+  YGM_ASSERT_RELEASE(m_preverse_adjacency->view().num_rows() ==
+                     pl_num_node_slots());
+  return m_preverse_adjacency->view();
+}
+
+void metall_graph::priv_undirected_adjacency(
+  const metall_graph::where_clause& where, metall_graph::csr_type& out) {
+  using entry = csr_type::entry;
+
+  csr_type scratch;
+  csr_view adj = priv_adjacency(where, scratch);
+
+  std::vector<entry>         staged;
+  static std::vector<entry>* sp_staged = nullptr;
+  sp_staged = &staged;
+  m_comm.barrier();
+
+  auto stage = [](local_node_idx_type row, node_locator nbr) {
+    sp_staged->push_back({row, nbr, edge_locator{}});
+  };
+
+  for (size_t i = 0; i < adj.num_rows(); ++i) {
+    local_node_idx_type uid{i};
+    auto                uloc = make_node_locator(m_comm.rank(), uid);
+    for (auto v : adj.neighbors(uid)) {
+      if (v == uloc) {
+        continue;
+      }
+      staged.push_back({uid, v, edge_locator{}});
+      m_comm.async(owner(v), stage, local(v), uloc);
+    }
+  }
+  m_comm.barrier();
+  sp_staged = nullptr;
+
+  std::sort(staged.begin(), staged.end());
+  staged.erase(std::unique(staged.begin(), staged.end()), staged.end());
+  out.build(pl_num_node_slots(), staged);
+}
+
+void metall_graph::priv_extend_adjacency(
+  metall_graph::local_edge_idx_type first_eid) {
+  using entry = persistent_csr_type::entry;
+
+  // Validity is set collectively, so all ranks take the same branches.
+  const bool extend_fwd = m_padjacency->valid();
+  const bool extend_rev = m_preverse_adjacency->valid();
+  m_pdegrees->invalidate();
+  if (!extend_fwd && !extend_rev) {
+    return;
+  }
+
+  std::vector<entry>         fwd_staged;
+  std::vector<entry>         rev_staged;
+  static std::vector<entry>* sp_fwd_staged = nullptr;
+  static std::vector<entry>* sp_rev_staged = nullptr;
+  sp_fwd_staged = &fwd_staged;
+  sp_rev_staged = &rev_staged;
+  m_comm.barrier();
+
+  auto stage_fwd = [](local_node_idx_type row, node_locator nbr,
+                      edge_locator el) {
+    sp_fwd_staged->push_back({row, nbr, el});
+  };
+  auto stage_rev = [](local_node_idx_type row, node_locator nbr,
+                      edge_locator el) {
+    sp_rev_staged->push_back({row, nbr, el});
+  };
+
+  for (size_t eid = std::to_underlying(first_eid);
+       eid < m_pedges->num_record_slots(); ++eid) {
+    if (!m_pedges->contains_record(eid)) {
+      continue;
+    }
+    local_edge_idx_type leid{eid};
+    auto [u, v] = pl_get_edge_uv_locators(leid);
+    auto el = make_edge_locator(m_comm.rank(), leid);
+    bool directed = pl_edge_is_directed(leid);
+    if (extend_fwd) {
+      m_comm.async(owner(u), stage_fwd, local(u), v, el);
+      if (!directed) {
+        m_comm.async(owner(v), stage_fwd, local(v), u, el);
+      }
+    }
+    if (extend_rev) {
+      m_comm.async(owner(v), stage_rev, local(v), u, el);
+      if (!directed) {
+        m_comm.async(owner(u), stage_rev, local(u), v, el);
+      }
+    }
+  }
+  m_comm.barrier();
+  sp_fwd_staged = nullptr;
+  sp_rev_staged = nullptr;
+
+  if (extend_fwd) {
+    m_padjacency->merge(pl_num_node_slots(), fwd_staged);
+  }
+  if (extend_rev) {
+    m_preverse_adjacency->merge(pl_num_node_slots(), rev_staged);
+  }
+}
+
+void metall_graph::priv_invalidate_adjacency() {
+  if (m_padjacency != nullptr) {
+    m_padjacency->invalidate();
+  }
+  if (m_preverse_adjacency != nullptr) {
+    m_preverse_adjacency->invalidate();
+  }
+  if (m_pdegrees != nullptr) {
+    m_pdegrees->invalidate();
+  }
+}
+
+}  // namespace metalldata
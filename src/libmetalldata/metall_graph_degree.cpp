@@ -3,9 +3,6 @@
 //
 // SPDX-License-Identifier: MIT
 
-// TODO: we could probably implement this with a counting set instead
-// of a map.
-
 #include <string>
 #include <utility>
 #include <variant>
@@ -18,13 +15,12 @@
 #include <cstdint>
 
 #include <ygm/comm.hpp>
-#include <ygm/io/parquet_parser.hpp>
 
 #include <metalldata/metall_graph.hpp>
 // #include <metall_jl/metall_jl.hpp>
 #include <fcntl.h>
 
-#include <boost/graph/graph_traits.hpp>
+#include <boost/unordered/unordered_flat_map.hpp>
 #include <multiseries/multiseries_record.hpp>
 #include <ygm/container/set.hpp>
 #include <ygm/container/counting_set.hpp>
@@ -43,6 +39,71 @@ result<> metall_graph::in_degree(series_name                       in_name,
   return priv_in_out_degree(in_name, where, false);
 }
 
+/**
+ * @brief Private helper computing in- and out-degrees of local nodes from an
+ * adjacency.
+ *
+ * Out-degree is the row length.  In-degree is the number of times a node
+ * appears as a neighbor; counts are combined per neighbor locator before a
+ * single message is sent to its owner.
+ *
+ * @param adj Forward adjacency
+ * @return std::pair<std::vector<int64_t>, std::vector<int64_t>> (in, out),
+ * indexed by local_node_idx_type
+ */
+std::pair<std::vector<int64_t>, std::vector<int64_t>>
+metall_graph::priv_degree_counts(metall_graph::csr_view adj) {
+  std::vector<int64_t> indeg(pl_num_node_slots(), 0);
+  std::vector<int64_t> outdeg(pl_num_node_slots(), 0);
+
+  static std::vector<int64_t>* sp_indeg = nullptr;
+  sp_indeg = &indeg;
+  m_comm.barrier();
+
+  boost::unordered_flat_map<node_locator, int64_t> remote_indeg;
+  for (size_t i = 0; i < adj.num_rows(); ++i) {
+    local_node_idx_type nid{i};
+    outdeg[i] = static_cast<int64_t>(adj.degree(nid));
+    for (auto v : adj.neighbors(nid)) {
+      if (is_local(v)) {
+        ++indeg[std::to_underlying(local(v))];
+      } else {
+        ++remote_indeg[v];
+      }
+    }
+  }
+  for (const auto& [v, count] : remote_indeg) {
+    m_comm.async(
+      owner(v),
+      [](local_node_idx_type nid, int64_t c) {
+        (*sp_indeg)[std::to_underlying(nid)] += c;
+      },
+      local(v), count);
+  }
+  m_comm.barrier();
+  sp_indeg = nullptr;
+
+  return {std::move(indeg), std::move(outdeg)};
+}
+
+std::pair<std::vector<int64_t>, std::vector<int64_t>>
+metall_graph::priv_degrees(const metall_graph::where_clause& where) {
+  csr_type scratch;
+  if (!where.empty()) {
+    return priv_degree_counts(priv_adjacency(where, scratch));
+  }
+
+  // Staleness is set collectively, so all ranks agree on whether to refill.
+  if (!m_pdegrees->valid()) {
+    auto [indeg, outdeg] = priv_degree_counts(priv_adjacency(where, scratch));
+    m_pdegrees->assign(indeg, outdeg);
+    return {std::move(indeg), std::move(outdeg)};
+  }
+  YGM_ASSERT_RELEASE(m_pdegrees->in_degree().size() == pl_num_node_slots());
+  return {{m_pdegrees->in_degree().begin(), m_pdegrees->in_degree().end()},
+          {m_pdegrees->out_degree().begin(), m_pdegrees->out_degree().end()}};
+}
+
 /**
  * @brief Private helper function for computing in-degree or out-degree.
  *
@@ -56,17 +117,6 @@ result<> metall_graph::in_degree(series_name                       in_name,
  */
 result<> metall_graph::priv_in_out_degree(
   series_name name, const metall_graph::where_clause& where, bool outdeg) {
-  using record_id_type = record_store_type::record_id_type;
-
-  edge_series_idx_type degcol, otherdegcol;
-  if (outdeg) {
-    degcol = m_u_col_idx;
-    otherdegcol = m_v_col_idx;
-  } else {
-    degcol = m_v_col_idx;
-    otherdegcol = m_u_col_idx;
-  }
-
   if (!name.is_node_series()) {
     return std::unexpected(
       std::format("invalid series name: {}", name.qualified()));
@@ -77,58 +127,21 @@ result<> metall_graph::priv_in_out_degree(
       std::format("series {} already exists", name.qualified()));
   }
 
-  auto                                      edges_ = m_pedges;
-  ygm::container::map<std::string, int64_t> degrees(m_comm);
+  auto [indeg, odeg] = priv_degrees(where);
+  const auto& deg = outdeg ? odeg : indeg;
 
-  std::vector<std::string> nodes;
+  std::map<local_node_idx_type, int64_t> local_deg;
   priv_for_all_nodes(
     [&](local_node_idx_type nid) {
-      std::string_view node_name = pl_get_node_label(nid);
-
-      degrees.async_insert(std::string(node_name), 0);
+      local_deg[nid] = deg[std::to_underlying(nid)];
     },
     where);
 
-  m_comm.barrier();
-  // ygm::container::counting_set<std::string> found_degrees(m_comm, nodes);
-  priv_for_all_edges(
-    [&](local_edge_idx_type eid) {
-      // Note: clangd may report a false positive error on the next line
-      // The code compiles and runs correctly
-      auto edge_name_o = pl_get_edge_field<std::string_view>(degcol, eid);
-      YGM_ASSERT_RELEASE(edge_name_o.has_value());
-      std::string_view edge_name = edge_name_o.value();
-      degrees.async_visit(std::string(edge_name),
-                          [](const auto& key, auto& val) { val++; });
-      // for undirected edges, add the reverse.
-      bool is_directed = pl_edge_is_directed(eid);
-      if (!is_directed) {
-        auto reverseedge_name_o =
-          pl_get_edge_field<std::string_view>(otherdegcol, eid);
-        YGM_ASSERT_RELEASE(reverseedge_name_o.has_value());
-        degrees.async_visit(std::string(reverseedge_name_o.value()),
-                            [](const auto& key, auto& val) { val++; });
-      }
-    },
-    where);
-
-  // not strictly required because the subsequent loop over degrees begins
-  // with a barrier. But that's spooky action at a distance, so we will be
-  // explicit here.
-  m_comm.barrier();
-
-  // for (const auto& [node_name, deg_ct] : found_degrees) {
-  //   degrees.async_insert_or_assign(node_name, deg_ct);
-  // }
-
-  m_comm.barrier();
-  return priv_set_node_series(name, degrees);
+  return priv_set_node_column_by_idx(name, local_deg);
 }
 
 result<> metall_graph::degrees(series_name in_name, series_name out_name,
                                const metall_graph::where_clause& where) {
-  using record_id_type = record_store_type::record_id_type;
-
   if (!in_name.is_node_series()) {
     return std::unexpected(
       std::format("invalid series name: {}", in_name.qualified()));
@@ -148,134 +161,29 @@ result<> metall_graph::degrees(series_name in_name, series_name out_name,
       std::format("series {} already exists", out_name.qualified()));
   }
 
-  ygm::container::map<std::string, int64_t> indegrees(m_comm);
-  ygm::container::map<std::string, int64_t> outdegrees(m_comm);
+  auto [indeg, outdeg] = priv_degrees(where);
 
+  std::map<local_node_idx_type, int64_t> local_indeg;
+  std::map<local_node_idx_type, int64_t> local_outdeg;
   priv_for_all_nodes(
     [&](local_node_idx_type nid) {
-      auto node_name = pl_get_node_label(nid);
-      indegrees.async_insert(std::string(node_name), 0);
-      outdegrees.async_insert(std::string(node_name), 0);
+      local_indeg[nid] = indeg[std::to_underlying(nid)];
+      local_outdeg[nid] = outdeg[std::to_underlying(nid)];
     },
     where);
 
-  m_comm.barrier();
-
-  priv_for_all_edges(
-    [&](local_edge_idx_type eid) {
-      // Note: clangd may report a false positive error on the next line
-      // The code compiles and runs correctly
-      auto [u, v] = pl_get_edge_uv_labels(eid);
-      std::string in_edge_name(u);
-      std::string out_edge_name(v);
-      indegrees.async_visit(in_edge_name,
-                            [&](const auto& key, auto& val) { val++; });
-
-      outdegrees.async_visit(out_edge_name,
-                             [&](const auto& key, auto& val) { val++; });
-
-      bool is_directed = pl_edge_is_directed(eid);
-      if (!is_directed) {
-        indegrees.async_visit(out_edge_name,
-                              [&](const auto& key, auto& val) { val++; });
-
-        outdegrees.async_visit(in_edge_name,
-                               [&](const auto& key, auto& val) { val++; });
-      }
-    },
-    where);
-
-  // not strictly required because the subsequent loop over degrees begins
-  // with a barrier. But that's spooky action at a distance, so we will be
-  // explicit here.
-  m_comm.barrier();
-
-  // TODO: we want to abstract this to priv_set_node_series because this is a
-  // common operation. Make this a private function inside metall_graph.
-
-  // create a node_local map of record id to node value.
-  std::map<std::string, local_node_idx_type> node_to_id{};
-  priv_for_all_nodes([&](local_node_idx_type nid) {
-    std::string_view node = pl_get_node_label(nid);
-    node_to_id[std::string(node)] = nid;
-  });
-
-  // create series and store index so we don't have to keep looking it up.
-  auto in_deg_idx = m_pnodes->add_series<int64_t>(in_name.unqualified());
-  auto out_deg_idx = m_pnodes->add_series<int64_t>(out_name.unqualified());
-
-  // add the values to the degrees series. We are taking advantage of the fact
-  // that the node information is local from the degrees shared counting set
-  // because it uses the same partitioning scheme as we used when we added the
-  // nodes in ingest.
-
-  auto to_return = priv_set_node_series(in_name, indegrees);
-  auto to_return2 = priv_set_node_series(out_name, outdegrees);
+  auto to_return = priv_set_node_column_by_idx(in_name, local_indeg);
+  auto to_return2 = priv_set_node_column_by_idx(out_name, local_outdeg);
   to_return.merge_warnings(to_return2);
 
   return to_return;
 }
 
+// degrees2 was an alternate counting_set implementation of degrees(); both now
+// read the adjacency index, so it is kept only for API compatibility.
 result<> metall_graph::degrees2(series_name in_name, series_name out_name,
                                 const metall_graph::where_clause& where) {
-  using record_id_type = record_store_type::record_id_type;
-
-  if (!in_name.is_node_series()) {
-    return std::unexpected(
-      std::format("invalid series name: {}", in_name.qualified()));
-  }
-
-  if (!out_name.is_node_series()) {
-    return std::unexpected(
-      std::format("invalid series name: {}", out_name.qualified()));
-  }
-
-  if (m_pnodes->contains_series(in_name.unqualified())) {
-    return std::unexpected(
-      std::format("series {} already exists", in_name.qualified()));
-  }
-  if (m_pnodes->contains_series(out_name.unqualified())) {
-    return std::unexpected(
-      std::format("series {} already exists", out_name.qualified()));
-  }
-
-  auto                                      edges_ = m_pedges;
-  ygm::container::counting_set<std::string> indegrees(m_comm);
-  ygm::container::counting_set<std::string> outdegrees(m_comm);
-
-  priv_for_all_edges(
-    [&](local_edge_idx_type eid) {
-      auto [u, v] = pl_get_edge_uv_labels(eid);
-      std::string in_edge_name(u);
-      std::string out_edge_name(v);
-      indegrees.async_insert(in_edge_name);
-      outdegrees.async_insert(out_edge_name);
-
-      auto is_directed = pl_edge_is_directed(eid);
-
-      if (!is_directed) {
-        indegrees.async_insert(out_edge_name);
-        outdegrees.async_insert(in_edge_name);
-      }
-    },
-    where);
-
-  // not strictly required because the subsequent loop over degrees begins
-  // with a barrier. But that's spooky action at a distance, so we will be
-  // explicit here.
-  m_comm.barrier();
-
-  std::map<std::string, int64_t> local_indeg_i64 = {indegrees.begin(),
-                                                    indegrees.end()};
-  std::map<std::string, int64_t> local_outdeg_i64 = {indegrees.begin(),
-                                                     indegrees.end()};
-  auto to_return = priv_set_node_series(in_name, local_indeg_i64);
-
-  auto to_return2 = priv_set_node_series(out_name, local_outdeg_i64);
-
-  to_return.merge_warnings(to_return2);
-
-  return to_return;
+  return degrees(in_name, out_name, where);
 }
 
 }  // namespace metalldata
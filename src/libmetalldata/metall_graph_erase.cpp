@@ -12,6 +12,12 @@ result<> metall_graph::erase_edges(const where_clause &where) {
   result<> to_return;
 
   priv_for_all_edges([&](auto rid) { m_pedges->remove_record(std::to_underlying(rid)); }, where);
+  priv_invalidate_adjacency();
+  // Removals cannot be folded into the maintained union-find; rebuild it.
+  m_pmaintained->invalidate();
+  if (auto rc = priv_refresh_maintained(local_edge_idx_type{0}); !rc) {
+    return std::unexpected(rc.error());
+  }
 
   return to_return;
 }
@@ -36,6 +42,11 @@ result<> metall_graph::erase_edges(
       m_pedges->remove_record(std::to_underlying(rid));
     }
   });
+  priv_invalidate_adjacency();
+  m_pmaintained->invalidate();
+  if (auto rc = priv_refresh_maintained(local_edge_idx_type{0}); !rc) {
+    return std::unexpected(rc.error());
+  }
 
   return to_return;
 }
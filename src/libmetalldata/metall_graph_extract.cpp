@@ -0,0 +1,222 @@
+// Copyright Lawrence Livermore National Security, LLC and other MetallData
+// Project Developers. See the top-level COPYRIGHT file for details.
+//
+// SPDX-License-Identifier: MIT
+
+#include <filesystem>
+#include <format>
+#include <map>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include <ygm/comm.hpp>
+#include <ygm/detail/collective.hpp>
+
+#include <metalldata/metall_graph.hpp>
+#include <string_table/string_store.hpp>
+#include <boost/unordered/unordered_flat_set.hpp>
+#include "ygm/utility/assert.hpp"
+
+namespace metalldata {
+
+namespace {
+
+/// Adds a series named name to dst with the type of series src_idx of src.
+template <typename Store>
+std::optional<size_t> add_series_like(const Store& src, size_t src_idx,
+                                      Store& dst, std::string_view name) {
+  if (src.template is_series_type<bool>(src_idx)) {
+    return dst.template add_series<bool>(name);
+  } else if (src.template is_series_type<int64_t>(src_idx)) {
+    return dst.template add_series<int64_t>(name);
+  } else if (src.template is_series_type<double>(src_idx)) {
+    return dst.template add_series<double>(name);
+  } else if (src.template is_series_type<std::string_view>(src_idx)) {
+    return dst.template add_series<std::string_view>(name);
+  }
+  return std::nullopt;
+}
+
+/// Copies field (src_idx, src_rid) of src to (dst_idx, dst_rid) of dst.
+template <typename Store>
+void copy_field(const Store& src, size_t src_idx, size_t src_rid, Store& dst,
+                size_t dst_idx, size_t dst_rid) {
+  auto val_o = src.get_dynamic(src_idx, src_rid);
+  if (!val_o.has_value()) {
+    return;
+  }
+  std::visit(
+    [&](const auto& v) {
+      using T = std::decay_t<decltype(v)>;
+      if constexpr (!std::is_same_v<T, std::monostate>) {
+        dst.set(dst_idx, dst_rid, v);
+      }
+    },
+    val_o.value());
+}
+
+}  // namespace
+
+/**
+ * The destination is opened on the same communicator, so every node keeps its
+ * owner and every edge stays on the rank that holds it.  Nodes are inserted
+ * through pasync_insert_node() of the destination, which also fills its label
+ * index on the ranks holding incident edges; endpoint locators are then
+ * filled as after an ingest.  Long strings of the copied rows are added to the
+ * destination's string store in one pass before any row is written.
+ */
+result<std::map<std::string, size_t>> metall_graph::extract_subgraph(
+  const where_clause& where, std::string_view dest_path,
+  const std::vector<series_name>& series) {
+  result<std::map<std::string, size_t>> to_return;
+
+  if (ygm::logical_or(std::filesystem::exists(dest_path), m_comm)) {
+    return std::unexpected(
+      std::format("path {} already exists", std::string(dest_path)));
+  }
+
+  //
+  // (source, destination) series indices to copy, besides the reserved ones
+  std::vector<std::pair<size_t, series_name>> node_series;
+  std::vector<std::pair<size_t, series_name>> edge_series;
+  for (const auto& sn : series) {
+    if (sn.is_reserved()) {
+      continue;
+    }
+    if (sn.is_node_series()) {
+      auto idx_o = m_pnodes->find_series(sn.unqualified());
+      if (idx_o.has_value()) {
+        node_series.emplace_back(idx_o.value(), sn);
+        continue;
+      }
+    } else if (sn.is_edge_series()) {
+      auto idx_o = m_pedges->find_series(sn.unqualified());
+      if (idx_o.has_value()) {
+        edge_series.emplace_back(idx_o.value(), sn);
+        continue;
+      }
+    }
+    to_return.add_warning(
+      std::format("series {} not found", sn.qualified()));
+  }
+
+  auto [nids, eids] = priv_where_subgraph(where);
+
+  metall_graph dest(m_comm, dest_path, false);
+  if (!dest.good()) {
+    return std::unexpected(
+      std::format("failed to create {}", std::string(dest_path)));
+  }
+
+  std::vector<std::pair<size_t, size_t>> node_copy;  // (source, destination)
+  for (const auto& [idx, sn] : node_series) {
+    auto dst_o = add_series_like(*m_pnodes, idx, *dest.m_pnodes,
+                                 sn.unqualified());
+    YGM_ASSERT_RELEASE(dst_o.has_value());
+    node_copy.emplace_back(idx, dst_o.value());
+  }
+  std::vector<std::pair<size_t, size_t>> edge_copy;
+  for (const auto& [idx, sn] : edge_series) {
+    auto dst_o = add_series_like(*m_pedges, idx, *dest.m_pedges,
+                                 sn.unqualified());
+    YGM_ASSERT_RELEASE(dst_o.has_value());
+    edge_copy.emplace_back(idx, dst_o.value());
+  }
+
+  //
+  // Bulk-add the long strings of every copied row.  Source strings are
+  // unique in the source store, so their addresses identify them.
+  {
+    constexpr size_t short_max =
+      compact_string::string_accessor::short_str_max_length();
+    boost::unordered_flat_set<const char*> seen;
+    std::vector<std::string_view>          strs;
+    auto collect = [&](const record_store_type& store, size_t idx,
+                       size_t rid) {
+      if (!store.is_series_type<std::string_view>(idx)) {
+        return;
+      }
+      auto val_o = store.get_dynamic(idx, rid);
+      if (!val_o.has_value() ||
+          !std::holds_alternative<std::string_view>(val_o.value())) {
+        return;
+      }
+      auto sv = std::get<std::string_view>(val_o.value());
+      if (sv.length() > short_max && seen.insert(sv.data()).second) {
+        strs.push_back(sv);
+      }
+    };
+    for (auto nid : nids) {
+      collect(*m_pnodes, std::to_underlying(m_node_col_idx),
+              std::to_underlying(nid));
+      for (const auto& [src, dst] : node_copy) {
+        collect(*m_pnodes, src, std::to_underlying(nid));
+      }
+    }
+    for (auto eid : eids) {
+      collect(*m_pedges, std::to_underlying(m_u_col_idx),
+              std::to_underlying(eid));
+      collect(*m_pedges, std::to_underlying(m_v_col_idx),
+              std::to_underlying(eid));
+      for (const auto& [src, dst] : edge_copy) {
+        collect(*m_pedges, src, std::to_underlying(eid));
+      }
+    }
+    dest.m_pstring_store->add_all(strs.begin(), strs.end());
+  }
+
+  //
+  // Nodes: selected nodes are local to their owner, so the insert requests
+  // are rank-local.  Endpoints of selected edges are always selected nodes.
+  for (auto nid : nids) {
+    dest.pasync_insert_node(pl_get_node_label(nid));
+  }
+  m_comm.barrier();
+
+  for (auto nid : nids) {
+    auto new_nid_o = dest.pl_get_node_id(pl_get_node_label(nid));
+    YGM_ASSERT_RELEASE(new_nid_o.has_value());
+    for (const auto& [src, dst] : node_copy) {
+      copy_field(*m_pnodes, src, std::to_underlying(nid), *dest.m_pnodes, dst,
+                 std::to_underlying(new_nid_o.value()));
+    }
+  }
+
+  //
+  // Edges
+  local_edge_idx_type first_new_eid{dest.m_pedges->num_record_slots()};
+  for (auto eid : eids) {
+    auto [ulb, vlb] = pl_get_edge_uv_labels(eid);
+    auto new_eid = local_edge_idx_type{dest.m_pedges->add_record()};
+    dest.pl_set_edge_field(dest.m_u_col_idx, new_eid, ulb);
+    dest.pl_set_edge_field(dest.m_v_col_idx, new_eid, vlb);
+    dest.pl_set_edge_field(dest.m_dir_col_idx, new_eid,
+                           pl_edge_is_directed(eid));
+    for (const auto& [src, dst] : edge_copy) {
+      copy_field(*m_pedges, src, std::to_underlying(eid), *dest.m_pedges, dst,
+                 std::to_underlying(new_eid));
+    }
+    dest.pasync_insert_node(ulb);
+    dest.pasync_insert_node(vlb);
+  }
+  m_comm.barrier();
+
+  size_t unresolved = dest.priv_fill_edge_locators(first_new_eid);
+  if (unresolved > 0) {
+    to_return.add_warnings(unresolved,
+                           "edges with unresolved endpoints removed");
+  }
+  dest.priv_invalidate_adjacency();
+
+  std::map<std::string, size_t> retdict{
+    {"num_nodes", ygm::sum(nids.size(), m_comm)},
+    {"num_edges", ygm::sum(eids.size(), m_comm)}};
+  to_return = retdict;
+  return to_return;
+}
+
+}  // namespace metalldata
@@ -53,11 +53,7 @@ void metall_graph::pasync_insert_node(std::string_view nlbv) {
 
     auto response = [](ygm_ptr_type pthis, const std::string& nlb,
                        node_locator nl) {
-      auto nlb_sa = compact_string::add_string(nlb, *(pthis->m_pstring_store));
-      pthis
-        ->m_pnode_to_locator[detail::ss_bank_hash{}(nlb_sa) %
-                             map_node_to_locator_bucket_count]
-        .insert_or_assign(nlb_sa, nl);
+      pthis->priv_index_node_locator(nlb, nl);
     };
 
     // 3. Send response back to requester so they can update their reverse
@@ -67,6 +63,14 @@ void metall_graph::pasync_insert_node(std::string_view nlbv) {
   m_comm.async(owner, request, pthis, m_comm.rank(), std::string{nlbv});
 }
 
+void metall_graph::priv_index_node_locator(std::string_view label,
+                                           node_locator     nl) {
+  auto lb_sa = compact_string::add_string(label, *m_pstring_store);
+  m_pnode_to_locator[detail::ss_bank_hash{}(lb_sa) %
+                     map_node_to_locator_bucket_count]
+    .insert_or_assign(lb_sa, nl);
+}
+
 std::optional<metall_graph::local_node_idx_type> metall_graph::pl_get_node_id(
   std::string_view label) const {
   auto nloc_o = pl_get_node_locator(label);
@@ -91,6 +95,40 @@ std::optional<metall_graph::node_locator> metall_graph::pl_get_node_locator(
   return std::nullopt;
 }
 
+size_t metall_graph::priv_fill_edge_locators(
+  metall_graph::local_edge_idx_type first_eid) {
+  size_t unresolved = 0;
+  auto   u_loc_col = std::to_underlying(m_u_loc_col_idx);
+  auto   v_loc_col = std::to_underlying(m_v_loc_col_idx);
+  for (size_t eid = std::to_underlying(first_eid);
+       eid < m_pedges->num_record_slots(); ++eid) {
+    if (!m_pedges->contains_record(eid)) {
+      continue;
+    }
+    auto ulb_o = pl_get_edge_field<std::string_view>(m_u_col_idx,
+                                                     local_edge_idx_type{eid});
+    auto vlb_o = pl_get_edge_field<std::string_view>(m_v_col_idx,
+                                                     local_edge_idx_type{eid});
+    std::optional<node_locator> uloc_o;
+    std::optional<node_locator> vloc_o;
+    if (ulb_o.has_value() && vlb_o.has_value()) {
+      uloc_o = pl_get_node_locator(ulb_o.value());
+      vloc_o = pl_get_node_locator(vlb_o.value());
+    }
+    // Every traversal relies on the locators, so such edges are dropped.
+    if (!uloc_o.has_value() || !vloc_o.has_value()) {
+      m_pedges->remove_record(eid);
+      ++unresolved;
+      continue;
+    }
+    m_pedges->set(u_loc_col, eid,
+                  static_cast<int64_t>(std::to_underlying(uloc_o.value())));
+    m_pedges->set(v_loc_col, eid,
+                  static_cast<int64_t>(std::to_underlying(vloc_o.value())));
+  }
+  return unresolved;
+}
+
 result<> metall_graph::priv_check_index_integrity() const {
   result<> to_return;
   //
@@ -125,6 +163,12 @@ result<> metall_graph::priv_check_index_integrity() const {
       return;
     }
 
+    auto [uloc, vloc] = pl_get_edge_uv_locators(eid);
+    if (uloc != uloc_o.value() || vloc != vloc_o.value()) {
+      to_return.add_warning();
+      return;
+    }
+
     int u_owner = m_partitioner.owner(ulb);
     if (u_owner != owner(uloc_o.value())) {
       to_return.add_warning();
@@ -13,6 +13,7 @@
 #include <cassert>
 #include <cstdint>
 #include <format>
+#include <optional>
 
 #include <ygm/comm.hpp>
 #include <ygm/io/parquet_parser.hpp>
@@ -154,8 +155,24 @@ result<std::map<std::string, size_t>> metall_graph::ingest_parquet_edges(
 
   size_t               local_nedges = 0;
   size_t               prior_global_nnodes = ygm::sum(pl_num_nodes(), m_comm);
+  local_edge_idx_type  first_new_eid{m_pedges->num_record_slots()};
   static metall_graph* sthis = nullptr;
   sthis = this;
+
+  // Resolve the metall series of every parquet column once per schema so the
+  // row loop does no name lookups.
+  std::vector<series_name>                      col_metall(parquet_cols.size());
+  std::vector<std::optional<series_index_type>> col_series_idx(
+    parquet_cols.size());
+  for (size_t i = 0; i < parquet_cols.size(); ++i) {
+    auto itr = parquet_to_metall.find(parquet_cols[i]);
+    if (itr == parquet_to_metall.end()) {
+      continue;
+    }
+    col_metall[i] = itr->second;
+    col_series_idx[i] = m_pedges->find_series(itr->second.unqualified());
+  }
+
   parquetp.for_all(
     parquet_cols,
     [&](const std::vector<ygm::io::parquet_parser::parquet_type_variant>& row) {
@@ -178,27 +195,21 @@ result<std::map<std::string, size_t>> metall_graph::ingest_parquet_edges(
       // first, set the directedness.
       pl_set_edge_field(m_dir_col_idx, local_edge_idx_type{rec}, directed);
       for (size_t i = 0; i < parquet_cols.size(); ++i) {
-        auto parquet_ser = parquet_cols[i];
-
-        // Skip columns that aren't in parquet_to_metall (not in metaset)
-        if (!parquet_to_metall.contains(parquet_ser)) {
+        // Skip columns that aren't in parquet_to_metall (not in metaset) or
+        // have no series (unsupported type).
+        if (!col_series_idx[i].has_value()) {
           continue;
         }
+        series_index_type metall_ser_idx = col_series_idx[i].value();
 
         auto parquet_val = row[i];
 
-        auto metall_ser = parquet_to_metall[parquet_ser];
+        const auto& metall_ser = col_metall[i];
         // memoization since we use this a few times.
         bool is_u_or_v = (metall_ser == series_name::U_COL ||
                           metall_ser == series_name::V_COL);
         // an edge is invalid if we have a type coercion problem
-        bool                             invalid_edge = false;
-        std::optional<series_index_type> metall_ser_idx_o =
-          m_pedges->find_series(metall_ser.unqualified());
-        if (!metall_ser_idx_o.has_value()) {
-          continue;
-        }
-        series_index_type metall_ser_idx = metall_ser_idx_o.value();
+        bool invalid_edge = false;
 
         auto add_val = [&](const auto& val) {
           using T = std::decay_t<decltype(val)>;
@@ -260,11 +271,25 @@ result<std::map<std::string, size_t>> metall_graph::ingest_parquet_edges(
     });  // for_all
 
   m_comm.barrier();
+
+  // All pasync_insert_node responses have arrived; persist the endpoint
+  // locators of the new edges so traversals never re-resolve labels.
+  size_t unresolved = priv_fill_edge_locators(first_new_eid);
+  if (unresolved > 0) {
+    to_return.add_warnings(unresolved,
+                           "edges with unresolved endpoints removed");
+  }
+  priv_extend_adjacency(first_new_eid);
+  if (auto rc = priv_refresh_maintained(first_new_eid); !rc) {
+    return std::unexpected(rc.error());
+  }
+
   std::map<std::string, size_t> retdict{
     {"num_edges_ingested", ygm::sum(local_nedges, m_comm)},
     {"num_new_nodes_ingested",
      ygm::sum(pl_num_nodes(), m_comm) - prior_global_nnodes}};
-  return retdict;
+  to_return = retdict;
+  return to_return;
 }
 
 result<std::map<std::string, size_t>> metall_graph::ingest_parquet_edges(
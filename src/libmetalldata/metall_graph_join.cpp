@@ -0,0 +1,150 @@
+// Copyright Lawrence Livermore National Security, LLC and other MetallData
+// Project Developers. See the top-level COPYRIGHT file for details.
+//
+// SPDX-License-Identifier: MIT
+
+#include <algorithm>
+#include <format>
+#include <string>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include <ygm/comm.hpp>
+#include <ygm/detail/collective.hpp>
+
+#include <metalldata/metall_graph.hpp>
+#include <boost/unordered/unordered_flat_map.hpp>
+#include "ygm/utility/assert.hpp"
+
+namespace metalldata {
+
+/**
+ * The distinct endpoint locators of the selected edges are requested from
+ * their owners in one message per owner rank, and the owners reply with the
+ * values in one message per requesting rank.  Edges are then written from
+ * the local cache.
+ */
+result<> metall_graph::join_node_series_to_edges(
+  const series_name& node_name, std::string_view endpoint,
+  const series_name& out_name, const where_clause& where) {
+  if (!node_name.is_node_series()) {
+    return std::unexpected(
+      std::format("invalid node series name: {}", node_name.qualified()));
+  }
+  auto nsid_o = pl_find_node_series(node_name);
+  if (!nsid_o.has_value()) {
+    return std::unexpected(
+      std::format("series {} not found", node_name.qualified()));
+  }
+  auto nsid = nsid_o.value();
+
+  if (!out_name.is_edge_series() || out_name.is_reserved()) {
+    return std::unexpected(
+      std::format("invalid series name: {}", out_name.qualified()));
+  }
+  if (m_pedges->contains_series(out_name.unqualified())) {
+    return std::unexpected(
+      std::format("series {} already exists", out_name.qualified()));
+  }
+
+  if (endpoint != "u" && endpoint != "v") {
+    return std::unexpected(std::format("endpoint must be u or v, got {}",
+                                       std::string(endpoint)));
+  }
+  const bool use_u = endpoint == "u";
+
+  std::vector<std::pair<local_edge_idx_type, node_locator>> targets;
+  priv_for_all_edges(
+    [&](local_edge_idx_type eid) {
+      auto [u, v] = pl_get_edge_uv_locators(eid);
+      targets.emplace_back(eid, use_u ? u : v);
+    },
+    where);
+
+  //
+  // Request every distinct locator once.
+  std::vector<std::vector<local_node_idx_type>> requests(m_comm.size());
+  {
+    std::vector<node_locator> needed;
+    needed.reserve(targets.size());
+    for (const auto& [eid, n] : targets) {
+      needed.push_back(n);
+    }
+    std::sort(needed.begin(), needed.end());
+    needed.erase(std::unique(needed.begin(), needed.end()), needed.end());
+    for (auto n : needed) {
+      requests[owner(n)].push_back(local(n));
+    }
+  }
+
+  boost::unordered_flat_map<node_locator, data_types>         values;
+  static boost::unordered_flat_map<node_locator, data_types>* sp_values =
+    nullptr;
+  static node_series_idx_type s_nsid;
+  sp_values = &values;
+  s_nsid = nsid;
+  m_comm.barrier();
+
+  static constexpr auto reply = [](const std::vector<node_locator>& ns,
+                                   const std::vector<data_types>&   vals) {
+    for (size_t i = 0; i < ns.size(); ++i) {
+      sp_values->emplace(ns[i], vals[i]);
+    }
+  };
+  auto lookup = [](ygm_ptr_type pthis, int from,
+                   const std::vector<local_node_idx_type>& nids) {
+    std::vector<node_locator> ns;
+    std::vector<data_types>   vals;
+    for (auto nid : nids) {
+      auto val_o = pthis->pl_get_node_field(s_nsid, nid);
+      if (val_o.has_value()) {
+        ns.push_back(make_node_locator(pthis->m_comm.rank(), nid));
+        vals.push_back(priv_series_to_data_type(val_o.value()));
+      }
+    }
+    pthis->m_comm.async(from, reply, ns, vals);
+  };
+  for (size_t dest = 0; dest < requests.size(); ++dest) {
+    if (!requests[dest].empty()) {
+      m_comm.async(dest, lookup, pthis, m_comm.rank(), requests[dest]);
+    }
+  }
+  m_comm.barrier();
+  sp_values = nullptr;
+
+  //
+  // The output has the type of the node series.
+  edge_series_idx_type out_sid;
+  if (priv_is_node_series_type<bool>(nsid)) {
+    out_sid = priv_add_edge_series<bool>(out_name.unqualified());
+  } else if (priv_is_node_series_type<int64_t>(nsid)) {
+    out_sid = priv_add_edge_series<int64_t>(out_name.unqualified());
+  } else if (priv_is_node_series_type<double>(nsid)) {
+    out_sid = priv_add_edge_series<double>(out_name.unqualified());
+  } else {
+    out_sid = priv_add_edge_series<std::string_view>(out_name.unqualified());
+  }
+
+  for (const auto& [eid, n] : targets) {
+    auto it = values.find(n);
+    if (it == values.end()) {
+      continue;
+    }
+    std::visit(
+      [&](const auto& val) {
+        using T = std::decay_t<decltype(val)>;
+        if constexpr (std::is_same_v<T, std::string>) {
+          pl_set_edge_field(out_sid, eid, std::string_view(val));
+        } else if constexpr (!std::is_same_v<T, std::monostate>) {
+          pl_set_edge_field(out_sid, eid, val);
+        }
+      },
+      it->second);
+  }
+  m_comm.barrier();
+
+  return {};
+}
+
+}  // namespace metalldata
@@ -0,0 +1,143 @@
+// Copyright Lawrence Livermore National Security, LLC and other MetallData
+// Project Developers. See the top-level COPYRIGHT file for details.
+//
+// SPDX-License-Identifier: MIT
+
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <ygm/comm.hpp>
+#include <ygm/detail/collective.hpp>
+
+#include <metalldata/metall_graph.hpp>
+#include "ygm/utility/assert.hpp"
+
+namespace metalldata {
+
+/**
+ * @brief Core numbers by h-index iteration (Montresor et al.).
+ *
+ * Every node starts at its degree and repeatedly lowers its estimate to the
+ * h-index of its neighbors' estimates, which converges to the core number.
+ * Each node keeps the last estimate heard from every neighbor, aligned with
+ * its adjacency row.  Only nodes whose estimate dropped notify their
+ * neighbors, and the updates for one round are combined into a single message
+ * per destination rank.
+ */
+result<> metall_graph::kcore(const series_name&                out_name,
+                             const metall_graph::where_clause& where) {
+  if (!out_name.is_node_series()) {
+    return std::unexpected(
+      std::format("invalid series name: {}", out_name.qualified()));
+  }
+
+  if (m_pnodes->contains_series(out_name.unqualified())) {
+    return std::unexpected(
+      std::format("series {} already exists", out_name.qualified()));
+  }
+
+  csr_type undirected;
+  priv_undirected_adjacency(where, undirected);
+  csr_view und = undirected.view();
+
+  std::vector<int64_t> core(pl_num_node_slots(), 0);
+  std::vector<int64_t> estimates(und.num_entries(),
+                                 std::numeric_limits<int64_t>::max());
+  std::vector<bool>    dirty(core.size(), false);
+  std::vector<local_node_idx_type> changed;
+  for (size_t i = 0; i < core.size(); ++i) {
+    core[i] = static_cast<int64_t>(und.degree(local_node_idx_type{i}));
+    if (core[i] > 0) {
+      changed.push_back(local_node_idx_type{i});
+    }
+  }
+
+  using update = std::tuple<local_node_idx_type, node_locator, int64_t>;
+
+  static csr_view              s_und;
+  static std::vector<int64_t>* sp_estimates = nullptr;
+  static std::vector<bool>*    sp_dirty = nullptr;
+  s_und = und;
+  sp_estimates = &estimates;
+  sp_dirty = &dirty;
+  m_comm.barrier();
+
+  auto receive = [](const std::vector<update>& updates) {
+    for (const auto& [vid, uloc, value] : updates) {
+      auto nbrs = s_und.neighbors(vid);
+      auto pos = std::lower_bound(nbrs.begin(), nbrs.end(), uloc);
+      YGM_ASSERT_DEBUG(pos != nbrs.end() && *pos == uloc);
+      (*sp_estimates)[s_und.offset(vid) + (pos - nbrs.begin())] = value;
+      (*sp_dirty)[std::to_underlying(vid)] = true;
+    }
+  };
+
+  std::vector<std::vector<update>> outgoing(m_comm.size());
+  std::vector<size_t>              counts;
+  while (ygm::sum(changed.size(), m_comm) > 0) {
+    for (auto uid : changed) {
+      auto uloc = make_node_locator(m_comm.rank(), uid);
+      for (auto v : und.neighbors(uid)) {
+        outgoing[owner(v)].emplace_back(local(v), uloc,
+                                        core[std::to_underlying(uid)]);
+      }
+    }
+    for (size_t dest = 0; dest < outgoing.size(); ++dest) {
+      if (outgoing[dest].empty()) {
+        continue;
+      }
+      if (dest == size_t(m_comm.rank())) {
+        receive(outgoing[dest]);
+      } else {
+        m_comm.async(dest, receive, outgoing[dest]);
+      }
+      outgoing[dest].clear();
+    }
+    m_comm.barrier();
+
+    changed.clear();
+    for (size_t i = 0; i < core.size(); ++i) {
+      if (!dirty[i]) {
+        continue;
+      }
+      dirty[i] = false;
+
+      // h-index of the neighbor estimates, capped by the current core.
+      local_node_idx_type nid{i};
+      auto                k = core[i];
+      counts.assign(k + 1, 0);
+      auto first = estimates.begin() + und.offset(nid);
+      for (auto it = first; it != first + und.degree(nid); ++it) {
+        ++counts[std::min(*it, k)];
+      }
+      int64_t h = k;
+      size_t  at_least = counts[k];
+      while (h > 0 && at_least < size_t(h)) {
+        --h;
+        at_least += counts[h];
+      }
+      if (h < core[i]) {
+        core[i] = h;
+        changed.push_back(nid);
+      }
+    }
+  }
+  s_und = csr_view{};
+  sp_estimates = nullptr;
+  sp_dirty = nullptr;
+
+  std::map<local_node_idx_type, int64_t> local_core;
+  priv_for_all_nodes(
+    [&](local_node_idx_type nid) {
+      local_core[nid] = core[std::to_underlying(nid)];
+    },
+    where);
+
+  return priv_set_node_column_by_idx(out_name, local_core);
+}
+
+}  // namespace metalldata
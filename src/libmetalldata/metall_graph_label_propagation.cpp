@@ -0,0 +1,186 @@
+// Copyright Lawrence Livermore National Security, LLC and other MetallData
+// Project Developers. See the top-level COPYRIGHT file for details.
+//
+// SPDX-License-Identifier: MIT
+
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <ygm/comm.hpp>
+#include <ygm/detail/collective.hpp>
+
+#include <metalldata/metall_graph.hpp>
+#include <boost/container_hash/hash.hpp>
+#include <boost/unordered/unordered_flat_map.hpp>
+#include "ygm/utility/assert.hpp"
+
+namespace metalldata {
+
+/**
+ * Labels start as each node's own locator.  Every node keeps the last label
+ * heard from each neighbor, aligned with its adjacency row; nodes whose label
+ * changed notify their neighbors, combined into one message per destination
+ * rank per iteration.
+ *
+ * A node updates only in iterations where its priority, a hash of its locator
+ * and the iteration, beats that of every neighbor.  Priorities are computed
+ * locally from the neighbor locators, so the updating nodes form an
+ * independent set without extra messages.
+ */
+result<std::map<std::string, size_t>> metall_graph::label_propagation(
+  const series_name& out_name, size_t max_iters,
+  const metall_graph::where_clause& where) {
+  result<std::map<std::string, size_t>> to_return;
+
+  if (!out_name.is_node_series()) {
+    return std::unexpected(
+      std::format("invalid series name: {}", out_name.qualified()));
+  }
+
+  if (m_pnodes->contains_series(out_name.unqualified())) {
+    return std::unexpected(
+      std::format("series {} already exists", out_name.qualified()));
+  }
+
+  csr_type undirected;
+  priv_undirected_adjacency(where, undirected);
+  csr_view und = undirected.view();
+
+  std::vector<int64_t> label(pl_num_node_slots());
+  std::vector<int64_t> nbr_labels(und.num_entries());
+  std::vector<local_node_idx_type> changed;
+  for (size_t i = 0; i < label.size(); ++i) {
+    local_node_idx_type nid{i};
+    label[i] = static_cast<int64_t>(
+      std::to_underlying(make_node_locator(m_comm.rank(), nid)));
+    if (und.degree(nid) > 0) {
+      changed.push_back(nid);
+    }
+  }
+
+  using update = std::tuple<local_node_idx_type, node_locator, int64_t>;
+
+  static csr_view              s_und;
+  static std::vector<int64_t>* sp_nbr_labels = nullptr;
+  s_und = und;
+  sp_nbr_labels = &nbr_labels;
+  m_comm.barrier();
+
+  auto receive = [](const std::vector<update>& updates) {
+    for (const auto& [vid, uloc, value] : updates) {
+      auto nbrs = s_und.neighbors(vid);
+      auto pos = std::lower_bound(nbrs.begin(), nbrs.end(), uloc);
+      YGM_ASSERT_DEBUG(pos != nbrs.end() && *pos == uloc);
+      (*sp_nbr_labels)[s_und.offset(vid) + (pos - nbrs.begin())] = value;
+    }
+  };
+
+  // Ties between priorities go to the larger locator.
+  auto priority = [](node_locator n, size_t iter) {
+    size_t seed = iter;
+    boost::hash_combine(seed, std::to_underlying(n));
+    return std::make_pair(seed, n);
+  };
+
+  std::vector<std::vector<update>>          outgoing(m_comm.size());
+  boost::unordered_flat_map<int64_t, size_t> counts;
+  size_t                                     num_iters = 0;
+  bool                                       converged = false;
+  for (size_t iter = 0; iter < max_iters; ++iter) {
+    ++num_iters;
+    for (auto uid : changed) {
+      auto uloc = make_node_locator(m_comm.rank(), uid);
+      for (auto v : und.neighbors(uid)) {
+        outgoing[owner(v)].emplace_back(local(v), uloc,
+                                        label[std::to_underlying(uid)]);
+      }
+    }
+    for (size_t dest = 0; dest < outgoing.size(); ++dest) {
+      if (outgoing[dest].empty()) {
+        continue;
+      }
+      if (dest == size_t(m_comm.rank())) {
+        receive(outgoing[dest]);
+      } else {
+        m_comm.async(dest, receive, outgoing[dest]);
+      }
+      outgoing[dest].clear();
+    }
+    m_comm.barrier();
+
+    //
+    // Every node finds its best label: the current one if it is among the most
+    // frequent, else the smallest most frequent one.  Only the nodes that win
+    // the priority draw adopt it.
+    changed.clear();
+    size_t pending = 0;
+    for (size_t i = 0; i < label.size(); ++i) {
+      local_node_idx_type nid{i};
+      if (und.degree(nid) == 0) {
+        continue;
+      }
+      counts.clear();
+      auto first = nbr_labels.begin() + und.offset(nid);
+      for (auto it = first; it != first + und.degree(nid); ++it) {
+        ++counts[*it];
+      }
+      size_t max_count = 0;
+      for (const auto& [l, c] : counts) {
+        max_count = std::max(max_count, c);
+      }
+      int64_t best = label[i];
+      if (!counts.contains(best) || counts.at(best) < max_count) {
+        best = std::numeric_limits<int64_t>::max();
+        for (const auto& [l, c] : counts) {
+          if (c == max_count && l < best) {
+            best = l;
+          }
+        }
+      }
+      if (best == label[i]) {
+        continue;
+      }
+      ++pending;
+      auto mine = priority(make_node_locator(m_comm.rank(), nid), iter);
+      bool wins = std::ranges::all_of(und.neighbors(nid), [&](node_locator v) {
+        return priority(v, iter) < mine;
+      });
+      if (wins) {
+        label[i] = best;
+        changed.push_back(nid);
+      }
+    }
+
+    // Labels are stable once no node wants to change.
+    if (ygm::sum(pending, m_comm) == 0) {
+      converged = true;
+      break;
+    }
+  }
+  s_und = csr_view{};
+  sp_nbr_labels = nullptr;
+
+  std::map<local_node_idx_type, int64_t> local_label;
+  priv_for_all_nodes(
+    [&](local_node_idx_type nid) {
+      local_label[nid] = label[std::to_underlying(nid)];
+    },
+    where);
+
+  auto rc = priv_set_node_column_by_idx(out_name, local_label);
+  if (!rc) {
+    return std::unexpected(rc.error());
+  }
+
+  std::map<std::string, size_t> retdict{{"num_iterations", num_iters},
+                                        {"converged", size_t(converged)}};
+  to_return = retdict;
+  return to_return;
+}
+
+}  // namespace metalldata
@@ -0,0 +1,200 @@
+// Copyright Lawrence Livermore National Security, LLC and other MetallData
+// Project Developers. See the top-level COPYRIGHT file for details.
+//
+// SPDX-License-Identifier: MIT
+
+#include <metalldata/metall_graph.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+#include <ygm/utility/assert.hpp>
+
+namespace metalldata {
+
+namespace {
+const metall_graph::series_name maintained_cc_col{"node.maintained_cc"};
+const metall_graph::series_name maintained_in_degree_col{
+  "node.maintained_in_degree"};
+const metall_graph::series_name maintained_out_degree_col{
+  "node.maintained_out_degree"};
+}  // namespace
+
+result<> metall_graph::enable_maintained_analytics() {
+  if (!m_pmaintained->enabled()) {
+    m_pmaintained->enable();
+  }
+  return priv_refresh_maintained(
+    local_edge_idx_type{m_pedges->num_record_slots()});
+}
+
+void metall_graph::disable_maintained_analytics() {
+  m_pmaintained->disable();
+}
+
+bool metall_graph::maintained_analytics_enabled() const {
+  return m_pmaintained->enabled();
+}
+
+result<> metall_graph::priv_refresh_maintained(
+  metall_graph::local_edge_idx_type first_eid) {
+  if (!m_pmaintained->enabled()) {
+    return result<>{};
+  }
+  auto changed = priv_update_maintained(first_eid);
+  return priv_write_maintained_series(changed);
+}
+
+std::optional<std::vector<metall_graph::local_node_idx_type>>
+metall_graph::priv_update_maintained(
+  metall_graph::local_edge_idx_type first_eid) {
+  auto&      state = *m_pmaintained;
+  const bool rebuild = !state.valid();
+  if (rebuild) {
+    state.clear();
+    first_eid = local_edge_idx_type{0};
+  }
+  const size_t old_size = state.size();
+  state.resize(m_comm.rank(), pl_num_node_slots());
+
+  // Nodes added since the last update have not been written yet.
+  std::vector<uint8_t> changed(state.size(), false);
+  std::fill(changed.begin() + old_size, changed.end(), true);
+
+  //
+  // Each new edge is sent to the owners of both endpoints, which bump the
+  // degree counters and keep the edge for the union-find.  Undirected edges
+  // count in both directions, as in the adjacency.
+  using batch_edge = std::pair<local_node_idx_type, node_locator>;
+  std::vector<batch_edge>         edges;
+  static std::vector<batch_edge>* sp_edges = nullptr;
+  static maintained_analytics*    sp_state = nullptr;
+  static std::vector<uint8_t>*    sp_changed = nullptr;
+  sp_edges = &edges;
+  sp_state = &state;
+  sp_changed = &changed;
+  m_comm.barrier();
+
+  auto add_endpoint = [](local_node_idx_type nid, node_locator nbr,
+                         int64_t dout, int64_t din) {
+    sp_edges->emplace_back(nid, nbr);
+    sp_state->out_degree()[std::to_underlying(nid)] += dout;
+    sp_state->in_degree()[std::to_underlying(nid)] += din;
+    (*sp_changed)[std::to_underlying(nid)] = true;
+  };
+
+  for (size_t eid = std::to_underlying(first_eid);
+       eid < m_pedges->num_record_slots(); ++eid) {
+    if (!m_pedges->contains_record(eid)) {
+      continue;
+    }
+    local_edge_idx_type leid{eid};
+    auto    [u, v] = pl_get_edge_uv_locators(leid);
+    int64_t both = pl_edge_is_directed(leid) ? 0 : 1;
+    m_comm.async(owner(u), add_endpoint, local(u), v, int64_t{1}, both);
+    m_comm.async(owner(v), add_endpoint, local(v), u, both, int64_t{1});
+  }
+  m_comm.barrier();
+  sp_edges = nullptr;
+  sp_state = nullptr;
+  sp_changed = nullptr;
+
+  //
+  // The stored forest is flat, so its parent pointers stand in for the edges
+  // already folded in; only the new edges need hooking.
+  std::vector<node_locator> parent(state.parent().begin(),
+                                   state.parent().end());
+  priv_fastsv(parent, edges);
+  for (size_t i = 0; i < parent.size(); ++i) {
+    if (parent[i] != state.parent()[i]) {
+      state.parent()[i] = parent[i];
+      changed[i] = true;
+    }
+  }
+  state.set_valid();
+
+  if (rebuild) {
+    return std::nullopt;
+  }
+  std::vector<local_node_idx_type> to_return;
+  for (size_t i = 0; i < changed.size(); ++i) {
+    if (changed[i] && m_pnodes->contains_record(i)) {
+      to_return.push_back(local_node_idx_type{i});
+    }
+  }
+  return to_return;
+}
+
+/**
+ * The series are created, from all nodes, after a rebuild or if any of them
+ * is missing.  Otherwise only the changed nodes are rewritten in place.
+ */
+result<> metall_graph::priv_write_maintained_series(
+  const std::optional<std::vector<local_node_idx_type>>& changed) {
+  const auto& state = *m_pmaintained;
+  const auto  idxs = pl_find_node_series(std::vector<series_name>{
+    maintained_cc_col, maintained_in_degree_col, maintained_out_degree_col});
+  const bool rewrite_all =
+    !changed.has_value() ||
+    std::ranges::any_of(idxs, [](const auto& o) { return !o.has_value(); });
+
+  std::vector<local_node_idx_type> nodes;
+  if (rewrite_all) {
+    priv_for_all_nodes(
+      [&](local_node_idx_type nid) { nodes.push_back(nid); });
+  } else {
+    nodes = changed.value();
+  }
+
+  std::set<node_locator> roots;
+  for (auto nid : nodes) {
+    roots.insert(state.parent()[std::to_underlying(nid)]);
+  }
+  auto labels = priv_gather_node_labels(roots);
+
+  if (!rewrite_all) {
+    for (auto nid : nodes) {
+      auto i = std::to_underlying(nid);
+      pl_set_node_field(idxs[0].value(), nid,
+                        std::string_view(labels.at(state.parent()[i])));
+      pl_set_node_field(idxs[1].value(), nid, state.in_degree()[i]);
+      pl_set_node_field(idxs[2].value(), nid, state.out_degree()[i]);
+    }
+    return result<>{};
+  }
+
+  for (const auto* name : {&maintained_cc_col, &maintained_in_degree_col,
+                           &maintained_out_degree_col}) {
+    m_pnodes->remove_series(name->unqualified());
+  }
+
+  std::map<local_node_idx_type, std::string> local_cc;
+  std::map<local_node_idx_type, int64_t>     local_indeg;
+  std::map<local_node_idx_type, int64_t>     local_outdeg;
+  for (auto nid : nodes) {
+    auto i = std::to_underlying(nid);
+    local_cc[nid] = labels.at(state.parent()[i]);
+    local_indeg[nid] = state.in_degree()[i];
+    local_outdeg[nid] = state.out_degree()[i];
+  }
+
+  auto rc = priv_set_node_column_by_idx(maintained_cc_col, local_cc);
+  if (!rc) {
+    return std::unexpected(rc.error());
+  }
+  rc = priv_set_node_column_by_idx(maintained_in_degree_col, local_indeg);
+  if (!rc) {
+    return std::unexpected(rc.error());
+  }
+  rc = priv_set_node_column_by_idx(maintained_out_degree_col, local_outdeg);
+  if (!rc) {
+    return std::unexpected(rc.error());
+  }
+  return result<>{};
+}
+
+}  // namespace metalldata
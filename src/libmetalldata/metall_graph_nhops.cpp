@@ -3,6 +3,7 @@
 //
 // SPDX-License-Identifier: MIT
 
+#include <algorithm>
 #include <string>
 #include <utility>
 #include <variant>
@@ -14,13 +15,14 @@
 #include <cstdint>
 
 #include <ygm/comm.hpp>
-#include <ygm/io/parquet_parser.hpp>
+#include <ygm/detail/collective.hpp>
 
 #include <metalldata/metall_graph.hpp>
 // #include <metall_jl/metall_jl.hpp>
 #include <fcntl.h>
 
 #include <boost/graph/graph_traits.hpp>
+#include <boost/unordered/unordered_flat_set.hpp>
 #include <multiseries/multiseries_record.hpp>
 #include <ygm/container/set.hpp>
 #include <ygm/container/counting_set.hpp>
@@ -29,6 +31,207 @@
 
 namespace metalldata {
 
+namespace {
+
+// Beamer et al. switching thresholds: go bottom-up when the frontier's
+// outgoing edges exceed 1/alpha of the unexplored edges, return top-down when
+// the frontier holds fewer than 1/beta of the nodes.
+constexpr size_t bfs_alpha = 14;
+constexpr size_t bfs_beta = 24;
+
+bool test_bit(const std::vector<uint64_t>& bits, size_t i) {
+  return (bits[i / 64] >> (i % 64)) & 1;
+}
+
+void set_bit(std::vector<uint64_t>& bits, size_t i) {
+  bits[i / 64] |= uint64_t(1) << (i % 64);
+}
+
+}  // namespace
+
+std::vector<int64_t> metall_graph::priv_bfs(
+  metall_graph::csr_view adj, const std::vector<local_node_idx_type>& sources,
+  size_t max_level, const metall_graph::where_clause& where) {
+  const size_t num_slots = pl_num_node_slots();
+  const size_t num_words = (num_slots + 63) / 64;
+
+  std::vector<int64_t>  dist(num_slots, -1);
+  std::vector<uint64_t> visited(num_words, 0);
+
+  std::vector<local_node_idx_type> frontier;
+  for (auto nid : sources) {
+    auto i = std::to_underlying(nid);
+    if (!test_bit(visited, i)) {
+      set_bit(visited, i);
+      dist[i] = 0;
+      frontier.push_back(nid);
+    }
+  }
+
+  std::vector<local_node_idx_type>         next_frontier;
+  std::vector<uint64_t>                    frontier_bits(num_words, 0);
+  static std::vector<int64_t>*             sp_dist = nullptr;
+  static std::vector<uint64_t>*            sp_visited = nullptr;
+  static std::vector<local_node_idx_type>* sp_next_frontier = nullptr;
+  static std::vector<uint64_t>*            sp_frontier_bits = nullptr;
+  // Remote frontier nodes found by the current bottom-up step
+  boost::unordered_flat_set<node_locator>         remote_frontier;
+  static boost::unordered_flat_set<node_locator>* sp_remote_frontier =
+    nullptr;
+  sp_dist = &dist;
+  sp_visited = &visited;
+  sp_next_frontier = &next_frontier;
+  sp_frontier_bits = &frontier_bits;
+  sp_remote_frontier = &remote_frontier;
+  m_comm.barrier();
+
+  auto visit = [](local_node_idx_type nid, int64_t d) {
+    auto i = std::to_underlying(nid);
+    if (!test_bit(*sp_visited, i)) {
+      set_bit(*sp_visited, i);
+      (*sp_dist)[i] = d;
+      sp_next_frontier->push_back(nid);
+    }
+  };
+
+  // Bottom-up: owners answer which of the requested nodes are in the
+  // frontier.
+  static constexpr auto reply = [](const std::vector<node_locator>& hits) {
+    sp_remote_frontier->insert(hits.begin(), hits.end());
+  };
+  auto probe = [](ygm_ptr_type pthis, int from,
+                  const std::vector<local_node_idx_type>& nids) {
+    std::vector<node_locator> hits;
+    for (auto nid : nids) {
+      if (test_bit(*sp_frontier_bits, std::to_underlying(nid))) {
+        hits.push_back(make_node_locator(pthis->m_comm.rank(), nid));
+      }
+    }
+    if (!hits.empty()) {
+      pthis->m_comm.async(from, reply, hits);
+    }
+  };
+
+  auto for_all_unvisited = [&](auto fn) {
+    for (size_t w = 0; w < num_words; ++w) {
+      if (visited[w] == ~uint64_t(0)) {
+        continue;
+      }
+      for (size_t i = w * 64; i < std::min(num_slots, (w + 1) * 64); ++i) {
+        if (!test_bit(visited, i)) {
+          fn(i);
+        }
+      }
+    }
+  };
+
+  //
+  // Unexplored edge count for the switching heuristic; decremented as nodes
+  // are reached.
+  size_t local_unexplored = adj.num_entries();
+  for (auto nid : frontier) {
+    local_unexplored -= adj.degree(nid);
+  }
+  const size_t global_nodes = ygm::sum(pl_num_nodes(), m_comm);
+
+  //
+  // The reverse adjacency is only built if a bottom-up step is taken.
+  csr_type rscratch;
+  csr_view radj;
+  bool     have_radj = false;
+  bool     bottom_up = false;
+
+  size_t global_frontier = ygm::sum(frontier.size(), m_comm);
+  for (int64_t level = 0;
+       level < static_cast<int64_t>(max_level) && global_frontier > 0;
+       ++level) {
+    size_t local_frontier_edges = 0;
+    for (auto nid : frontier) {
+      local_frontier_edges += adj.degree(nid);
+    }
+    size_t frontier_edges = ygm::sum(local_frontier_edges, m_comm);
+    size_t unexplored = ygm::sum(local_unexplored, m_comm);
+
+    if (!bottom_up && frontier_edges > unexplored / bfs_alpha) {
+      bottom_up = true;
+    } else if (bottom_up && global_frontier < global_nodes / bfs_beta) {
+      bottom_up = false;
+    }
+
+    if (bottom_up) {
+      if (!have_radj) {
+        radj = priv_reverse_adjacency(where, adj, rscratch);
+        have_radj = true;
+      }
+
+      //
+      // Frontier membership is fetched only for the distinct remote
+      // in-neighbors of this rank's unvisited nodes, one request per owner.
+      std::fill(frontier_bits.begin(), frontier_bits.end(), 0);
+      for (auto nid : frontier) {
+        set_bit(frontier_bits, std::to_underlying(nid));
+      }
+      remote_frontier.clear();
+      std::vector<std::vector<local_node_idx_type>> requests(m_comm.size());
+      for_all_unvisited([&](size_t i) {
+        for (auto u : radj.neighbors(local_node_idx_type{i})) {
+          if (!is_local(u)) {
+            requests[owner(u)].push_back(local(u));
+          }
+        }
+      });
+      for (size_t dest = 0; dest < requests.size(); ++dest) {
+        auto& nids = requests[dest];
+        if (nids.empty()) {
+          continue;
+        }
+        std::sort(nids.begin(), nids.end());
+        nids.erase(std::unique(nids.begin(), nids.end()), nids.end());
+        m_comm.async(dest, probe, pthis, m_comm.rank(), nids);
+      }
+      m_comm.barrier();
+
+      for_all_unvisited([&](size_t i) {
+        for (auto u : radj.neighbors(local_node_idx_type{i})) {
+          if (is_local(u)
+                ? test_bit(frontier_bits, std::to_underlying(local(u)))
+                : remote_frontier.contains(u)) {
+            set_bit(visited, i);
+            dist[i] = level + 1;
+            next_frontier.push_back(local_node_idx_type{i});
+            break;
+          }
+        }
+      });
+    } else {
+      for (auto u : frontier) {
+        for (auto v : adj.neighbors(u)) {
+          if (is_local(v)) {
+            visit(local(v), level + 1);
+          } else {
+            m_comm.async(owner(v), visit, local(v), level + 1);
+          }
+        }
+      }
+      m_comm.barrier();
+    }
+
+    for (auto nid : next_frontier) {
+      local_unexplored -= adj.degree(nid);
+    }
+    frontier.swap(next_frontier);
+    next_frontier.clear();
+    global_frontier = ygm::sum(frontier.size(), m_comm);
+  }
+  sp_dist = nullptr;
+  sp_visited = nullptr;
+  sp_next_frontier = nullptr;
+  sp_frontier_bits = nullptr;
+  sp_remote_frontier = nullptr;
+
+  return dist;
+}
+
 result<> metall_graph::nhops(const series_name& out_name, size_t nhops,
                              const std::vector<std::string>& sources,
                              const where_clause&             where) {
@@ -42,30 +245,25 @@ result<> metall_graph::nhops(const series_name& out_name, size_t nhops,
       std::format("series {} already exists", out_name.qualified()));
   }
 
-  auto u_col = std::to_underlying(m_u_col_idx);
-  auto v_col = std::to_underlying(m_v_col_idx);
-  auto dir_col = std::to_underlying(m_dir_col_idx);
-
-  // TODO: convert to (rank, node row id) tuples.
-  ygm::container::map<std::string, std::vector<std::string>> adj_list(m_comm);
-
-  priv_for_all_edges(
-    [&](local_edge_idx_type eid) {
-      auto [u, v] = pl_get_edge_uv_labels(eid);
-
-      bool is_directed = pl_edge_is_directed(eid);
-      auto adj_inserter = [](const std::string&, std::vector<std::string>& adj,
-                             const std::string& vert) { adj.push_back(vert); };
-      adj_list.async_visit(std::string(u), adj_inserter, std::string(v));
-      if (!is_directed) {
-        adj_list.async_visit(std::string(v), adj_inserter, std::string(u));
-      }
-    },
-    where);
+  csr_type scratch;
+  csr_view adj = priv_adjacency(where, scratch);
 
-  std::vector<std::string> missing_vertices;
+  //
+  // Sources are resolved by the rank that owns them.  A source is missing if
+  // it has no outgoing adjacency in the (filtered) graph.
+  std::vector<local_node_idx_type> frontier;
+  std::vector<std::string>         missing_vertices;
   for (const auto& source : sources) {
-    if (!adj_list.contains(source)) {
+    bool missing = false;
+    if (m_partitioner.owner(source) == m_comm.rank()) {
+      auto nid_o = pl_get_node_id(source);
+      if (nid_o.has_value() && adj.degree(nid_o.value()) > 0) {
+        frontier.push_back(nid_o.value());
+      } else {
+        missing = true;
+      }
+    }
+    if (ygm::logical_or(missing, m_comm)) {
       missing_vertices.push_back(source);
     }
   }
@@ -78,35 +276,15 @@ result<> metall_graph::nhops(const series_name& out_name, size_t nhops,
     return std::unexpected(error);
   }
 
-  std::map<std::string, int64_t>   local_nhop_map;
-  ygm::container::set<std::string> visited(m_comm, sources), cur_level(m_comm),
-    next_level(m_comm, sources);
-  size_t cur_level_dist = 0;
-
-  static auto* sp_visited = &visited;
-  static auto* sp_next_level = &next_level;
-
-  while (next_level.size() > 0 && cur_level_dist <= nhops) {
-    cur_level.swap(next_level);
-    next_level.clear();
-    for (const std::string& v : cur_level) {
-      local_nhop_map[v] = static_cast<int64_t>(cur_level_dist);
-      if (adj_list.local_count(v) > 0) {
-        for (const auto& neighbor : adj_list.local_at(v)) {
-          visited.async_contains(neighbor,
-                                 [](bool found, const std::string& node) {
-                                   if (!found) {
-                                     sp_visited->local_insert(node);
-                                     sp_next_level->local_insert(node);
-                                   }
-                                 });
-        }
-      }
-    }
+  auto dist = priv_bfs(adj, frontier, nhops, where);
 
-    ++cur_level_dist;
+  std::map<local_node_idx_type, int64_t> local_nhop_map;
+  for (size_t i = 0; i < dist.size(); ++i) {
+    if (dist[i] >= 0) {
+      local_nhop_map[local_node_idx_type{i}] = dist[i];
+    }
   }
 
-  return priv_set_node_series(out_name, local_nhop_map);
+  return priv_set_node_column_by_idx(out_name, local_nhop_map);
 }
 }  // namespace metalldata
@@ -0,0 +1,189 @@
+// Copyright Lawrence Livermore National Security, LLC and other MetallData
+// Project Developers. See the top-level COPYRIGHT file for details.
+//
+// SPDX-License-Identifier: MIT
+
+#include <cmath>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <ygm/comm.hpp>
+#include <ygm/detail/collective.hpp>
+
+#include <metalldata/metall_graph.hpp>
+#include <boost/unordered/unordered_flat_map.hpp>
+#include "ygm/utility/assert.hpp"
+
+namespace metalldata {
+
+result<> metall_graph::pagerank(const series_name& out_name, double damping,
+                                double tol, size_t max_iter,
+                                const where_clause& where) {
+  return priv_pagerank(out_name, {}, damping, tol, max_iter, where);
+}
+
+result<> metall_graph::personalized_pagerank(
+  const series_name& out_name, const std::vector<std::string>& sources,
+  double damping, double tol, size_t max_iter, const where_clause& where) {
+  if (sources.empty()) {
+    return std::unexpected("personalized pagerank requires sources");
+  }
+  return priv_pagerank(out_name, sources, damping, tol, max_iter, where);
+}
+
+/**
+ * @brief Private helper for pagerank() and personalized_pagerank().  An empty
+ * source list means uniform teleport.
+ *
+ * Each iteration pushes rank along the forward adjacency.  Contributions to
+ * remote neighbors are summed per neighbor locator first, so every rank sends
+ * at most one message per distinct remote neighbor.
+ */
+result<> metall_graph::priv_pagerank(const series_name&              out_name,
+                                     const std::vector<std::string>& sources,
+                                     double damping, double tol,
+                                     size_t max_iter,
+                                     const where_clause& where) {
+  if (!out_name.is_node_series()) {
+    return std::unexpected(
+      std::format("invalid series name: {}", out_name.qualified()));
+  }
+
+  if (m_pnodes->contains_series(out_name.unqualified())) {
+    return std::unexpected(
+      std::format("series {} already exists", out_name.qualified()));
+  }
+
+  if (!(damping >= 0.0 && damping < 1.0)) {
+    return std::unexpected(
+      std::format("damping must be in [0, 1), got {}", damping));
+  }
+
+  csr_type scratch;
+  csr_view adj = priv_adjacency(where, scratch);
+
+  std::vector<bool> active(pl_num_node_slots(), false);
+  priv_for_all_nodes(
+    [&](local_node_idx_type nid) { active[std::to_underlying(nid)] = true; },
+    where);
+  size_t local_active = 0;
+  for (bool a : active) {
+    local_active += a;
+  }
+  size_t global_active = ygm::sum(local_active, m_comm);
+  if (global_active == 0) {
+    return result<>{};
+  }
+
+  //
+  // Teleport distribution: uniform over active nodes, or uniform over the
+  // sources.  Sources are resolved by the rank that owns them.
+  std::vector<double> teleport(pl_num_node_slots(), 0.0);
+  if (sources.empty()) {
+    for (size_t i = 0; i < teleport.size(); ++i) {
+      if (active[i]) {
+        teleport[i] = 1.0 / double(global_active);
+      }
+    }
+  } else {
+    std::vector<local_node_idx_type> local_sources;
+    std::vector<std::string>         missing_vertices;
+    for (const auto& source : sources) {
+      bool missing = false;
+      if (m_partitioner.owner(source) == m_comm.rank()) {
+        auto nid_o = pl_get_node_id(source);
+        if (nid_o.has_value() && active[std::to_underlying(nid_o.value())]) {
+          local_sources.push_back(nid_o.value());
+        } else {
+          missing = true;
+        }
+      }
+      if (ygm::logical_or(missing, m_comm)) {
+        missing_vertices.push_back(source);
+      }
+    }
+    if (!missing_vertices.empty()) {
+      std::string error = "source vertex/vertices invalid or missing: ";
+      for (size_t i = 0; i < missing_vertices.size(); ++i) {
+        if (i > 0) error += ", ";
+        error += missing_vertices[i];
+      }
+      return std::unexpected(error);
+    }
+    size_t num_sources = ygm::sum(local_sources.size(), m_comm);
+    for (auto nid : local_sources) {
+      teleport[std::to_underlying(nid)] += 1.0 / double(num_sources);
+    }
+  }
+
+  std::vector<double> rank(teleport);
+  std::vector<double> next(pl_num_node_slots(), 0.0);
+
+  static std::vector<double>* sp_next = nullptr;
+  sp_next = &next;
+  m_comm.barrier();
+
+  boost::unordered_flat_map<node_locator, double> remote_contrib;
+  for (size_t iter = 0; iter < max_iter; ++iter) {
+    std::fill(next.begin(), next.end(), 0.0);
+    remote_contrib.clear();
+
+    double local_dangling = 0.0;
+    for (size_t i = 0; i < rank.size(); ++i) {
+      if (!active[i]) {
+        continue;
+      }
+      auto nbrs = adj.neighbors(local_node_idx_type{i});
+      if (nbrs.empty()) {
+        local_dangling += rank[i];
+        continue;
+      }
+      double share = damping * rank[i] / double(nbrs.size());
+      for (auto v : nbrs) {
+        if (is_local(v)) {
+          next[std::to_underlying(local(v))] += share;
+        } else {
+          remote_contrib[v] += share;
+        }
+      }
+    }
+    for (const auto& [v, contrib] : remote_contrib) {
+      m_comm.async(
+        owner(v),
+        [](local_node_idx_type nid, double c) {
+          (*sp_next)[std::to_underlying(nid)] += c;
+        },
+        local(v), contrib);
+    }
+    m_comm.barrier();
+
+    double dangling = ygm::sum(local_dangling, m_comm);
+    double local_delta = 0.0;
+    for (size_t i = 0; i < next.size(); ++i) {
+      if (!active[i]) {
+        continue;
+      }
+      next[i] += (1.0 - damping + damping * dangling) * teleport[i];
+      local_delta += std::abs(next[i] - rank[i]);
+    }
+    rank.swap(next);
+
+    if (ygm::sum(local_delta, m_comm) < tol) {
+      break;
+    }
+  }
+  sp_next = nullptr;
+
+  std::map<local_node_idx_type, double> local_rank;
+  for (size_t i = 0; i < rank.size(); ++i) {
+    if (active[i]) {
+      local_rank[local_node_idx_type{i}] = rank[i];
+    }
+  }
+
+  return priv_set_node_column_by_idx(out_name, local_rank);
+}
+
+}  // namespace metalldata
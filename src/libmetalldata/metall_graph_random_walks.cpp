@@ -0,0 +1,304 @@
+// Copyright Lawrence Livermore National Security, LLC and other MetallData
+// Project Developers. See the top-level COPYRIGHT file for details.
+//
+// SPDX-License-Identifier: MIT
+
+#include <algorithm>
+#include <any>
+#include <cstdint>
+#include <format>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <ygm/comm.hpp>
+#include <ygm/detail/collective.hpp>
+
+#include <metalldata/metall_graph.hpp>
+#include <parquet_writer/parquet_writer.hpp>
+#include "ygm/utility/assert.hpp"
+
+namespace {
+using RC = std::map<std::string, std::any>;
+}
+
+namespace metalldata {
+
+/**
+ * Walkers advance one step per round and carry only their walk id, step, the
+ * node they came from and the node they are at.  Each rank writes a
+ * (walk_id, step, node) row for every walker visiting one of its nodes, so
+ * labels never travel.  A second-order (node2vec) step asks the owner of the
+ * previous node which of the current node's neighbors are adjacent to it.
+ * Walkers and membership queries are batched into one message per
+ * destination rank per round.  The walks are started in num_walks waves of
+ * one walk per node, so at most one wave is in flight.
+ */
+result<RC> metall_graph::random_walks(size_t num_walks, size_t walk_len,
+                                      double p, double q,
+                                      std::optional<uint64_t> optseed,
+                                      const where_clause&     where,
+                                      std::string_view out_path,
+                                      bool             overwrite) {
+  result<RC> to_return;
+
+  if (walk_len == 0) {
+    return std::unexpected("walk length must be positive");
+  }
+  if (!(p > 0.0 && q > 0.0)) {
+    return std::unexpected(
+      std::format("p and q must be positive, got p={} q={}", p, q));
+  }
+
+  std::string filename =
+    std::format("{}_{}.parquet", std::string(out_path), m_comm.rank());
+
+  bool exists = false;
+  if (!overwrite) {
+    std::ifstream file_check(filename);
+    exists = file_check.good();
+  }
+  if (ygm::logical_or(exists, m_comm)) {
+    return std::unexpected(std::format(
+      "file '{}' already exists and overwrite is false", filename));
+  }
+
+  std::unique_ptr<parquet_writer::ParquetWriter> writer;
+  std::string                                    writer_error;
+  try {
+    writer = std::make_unique<parquet_writer::ParquetWriter>(
+      filename, std::vector<std::string>{"walk_id:i", "step:i", "node:s"});
+    if (!writer->is_valid()) {
+      writer_error = "failed to create Parquet writer";
+    }
+  } catch (const std::exception& e) {
+    writer_error = std::format("exception: {}", e.what());
+  }
+  if (ygm::logical_or(!writer_error.empty(), m_comm)) {
+    return std::unexpected(writer_error.empty()
+                             ? std::string("failed to create Parquet writer")
+                             : writer_error);
+  }
+
+  csr_type scratch;
+  csr_view adj = priv_adjacency(where, scratch);
+
+  std::vector<local_node_idx_type> starts;
+  priv_for_all_nodes([&](local_node_idx_type nid) { starts.push_back(nid); },
+                     where);
+
+  // Walk ids are numbered by start node across ranks, then by wave.
+  const auto num_starts = int64_t(ygm::sum(starts.size(), m_comm));
+  const auto first_start = int64_t(ygm::prefix_sum(starts.size(), m_comm));
+
+  // p == q == 1 is an unbiased walk; walkers then skip N(prev).
+  const bool biased = p != 1.0 || q != 1.0;
+
+  // (walk id, step, previous node, current node)
+  using walker =
+    std::tuple<int64_t, int64_t, node_locator, local_node_idx_type>;
+
+  std::vector<walker>         walkers;
+  std::vector<walker>         next_walkers;
+  static std::vector<walker>* sp_next_walkers = nullptr;
+  // Per walker, whether each neighbor of its current node is adjacent to its
+  // previous node.
+  std::vector<std::vector<uint8_t>>         common;
+  static std::vector<std::vector<uint8_t>>* sp_common = nullptr;
+  static const csr_view*                    sp_adj = nullptr;
+  sp_next_walkers = &next_walkers;
+  sp_common = &common;
+  sp_adj = &adj;
+  m_comm.barrier();
+
+  auto receive = [](const std::vector<walker>& ws) {
+    sp_next_walkers->insert(sp_next_walkers->end(), ws.begin(), ws.end());
+  };
+
+  static constexpr auto answer = [](const std::vector<size_t>&  slots,
+                                    const std::vector<uint8_t>& flags) {
+    size_t k = 0;
+    for (auto slot : slots) {
+      auto& c = (*sp_common)[slot];
+      std::copy_n(flags.begin() + k, c.size(), c.begin());
+      k += c.size();
+    }
+  };
+  auto membership = [](ygm_ptr_type pthis, int from,
+                       const std::vector<size_t>&              slots,
+                       const std::vector<local_node_idx_type>& prevs,
+                       const std::vector<size_t>&              counts,
+                       const std::vector<node_locator>&        candidates) {
+    std::vector<uint8_t> flags;
+    flags.reserve(candidates.size());
+    size_t k = 0;
+    for (size_t i = 0; i < prevs.size(); ++i) {
+      auto prev_nbrs = sp_adj->neighbors(prevs[i]);
+      for (size_t j = 0; j < counts[i]; ++j, ++k) {
+        flags.push_back(std::binary_search(prev_nbrs.begin(), prev_nbrs.end(),
+                                           candidates[k]));
+      }
+    }
+    pthis->m_comm.async(from, answer, slots, flags);
+  };
+
+  std::mt19937_64 gen(optseed.value_or(0) +
+                      0x9e3779b97f4a7c15ULL * uint64_t(m_comm.rank() + 1));
+  std::uniform_real_distribution<double> unit(0.0, 1.0);
+  std::vector<double>                    cumulative;
+
+  size_t rows_written = 0;
+  size_t write_errors = 0;
+
+  struct membership_query {
+    std::vector<size_t>              slots;
+    std::vector<local_node_idx_type> prevs;
+    std::vector<size_t>              counts;
+    std::vector<node_locator>        candidates;
+  };
+  std::vector<membership_query>    queries(m_comm.size());
+  std::vector<std::vector<walker>> outgoing(m_comm.size());
+  for (size_t wave = 0; wave < num_walks; ++wave) {
+    walkers.clear();
+    for (size_t i = 0; i < starts.size(); ++i) {
+      int64_t id = int64_t(wave) * num_starts + first_start + int64_t(i);
+      walkers.emplace_back(id, 0, node_locator{}, starts[i]);
+    }
+
+    while (ygm::sum(walkers.size(), m_comm) > 0) {
+      //
+      // Record the visits and drop the walkers that end here.
+      size_t kept = 0;
+      for (const auto& w : walkers) {
+        const auto& [id, step, prev, cur] = w;
+        auto status = writer->write_row(id, step, pl_get_node_label(cur));
+        if (status.ok()) {
+          ++rows_written;
+        } else {
+          ++write_errors;
+        }
+        if (size_t(step) + 1 < walk_len && adj.degree(cur) > 0) {
+          walkers[kept++] = w;
+        }
+      }
+      walkers.resize(kept);
+
+      //
+      // node2vec needs to know which neighbors of cur are adjacent to prev.
+      // The first step has no prev and is uniform.
+      common.assign(walkers.size(), {});
+      if (biased) {
+        for (size_t slot = 0; slot < walkers.size(); ++slot) {
+          const auto& [id, step, prev, cur] = walkers[slot];
+          if (step == 0) {
+            continue;
+          }
+          auto nbrs = adj.neighbors(cur);
+          common[slot].resize(nbrs.size());
+          if (is_local(prev)) {
+            auto prev_nbrs = adj.neighbors(local(prev));
+            for (size_t j = 0; j < nbrs.size(); ++j) {
+              common[slot][j] = std::binary_search(prev_nbrs.begin(),
+                                                   prev_nbrs.end(), nbrs[j]);
+            }
+            continue;
+          }
+          auto& query = queries[owner(prev)];
+          query.slots.push_back(slot);
+          query.prevs.push_back(local(prev));
+          query.counts.push_back(nbrs.size());
+          query.candidates.insert(query.candidates.end(), nbrs.begin(),
+                                  nbrs.end());
+        }
+        for (size_t dest = 0; dest < queries.size(); ++dest) {
+          auto& query = queries[dest];
+          if (!query.slots.empty()) {
+            m_comm.async(dest, membership, pthis, m_comm.rank(), query.slots,
+                         query.prevs, query.counts, query.candidates);
+            query = membership_query{};
+          }
+        }
+        m_comm.barrier();
+      }
+
+      for (size_t slot = 0; slot < walkers.size(); ++slot) {
+        auto& w = walkers[slot];
+        auto& [id, step, prev, cur] = w;
+        auto nbrs = adj.neighbors(cur);
+
+        //
+        // node2vec weights: 1/p back to prev, 1 to common neighbors of prev,
+        // 1/q otherwise.
+        size_t pick = 0;
+        if (!biased || step == 0) {
+          std::uniform_int_distribution<size_t> uniform(0, nbrs.size() - 1);
+          pick = uniform(gen);
+        } else {
+          cumulative.resize(nbrs.size());
+          double total = 0.0;
+          for (size_t j = 0; j < nbrs.size(); ++j) {
+            if (nbrs[j] == prev) {
+              total += 1.0 / p;
+            } else if (common[slot][j]) {
+              total += 1.0;
+            } else {
+              total += 1.0 / q;
+            }
+            cumulative[j] = total;
+          }
+          pick = std::upper_bound(cumulative.begin(), cumulative.end(),
+                                  unit(gen) * total) -
+                 cumulative.begin();
+          pick = std::min(pick, nbrs.size() - 1);
+        }
+
+        auto next = nbrs[pick];
+        ++step;
+        prev = make_node_locator(m_comm.rank(), cur);
+        cur = local(next);
+        if (is_local(next)) {
+          next_walkers.push_back(w);
+        } else {
+          outgoing[owner(next)].push_back(w);
+        }
+      }
+      for (size_t dest = 0; dest < outgoing.size(); ++dest) {
+        if (!outgoing[dest].empty()) {
+          m_comm.async(dest, receive, outgoing[dest]);
+          outgoing[dest].clear();
+        }
+      }
+      m_comm.barrier();
+      walkers.swap(next_walkers);
+      next_walkers.clear();
+    }
+  }
+  sp_next_walkers = nullptr;
+  sp_common = nullptr;
+  sp_adj = nullptr;
+
+  if (write_errors > 0) {
+    to_return.add_warnings(write_errors, "write error");
+  }
+  if (!writer->flush().ok()) {
+    to_return.add_warning("flush failed");
+  }
+  if (!writer->close().ok()) {
+    to_return.add_warning("close failed");
+  }
+
+  RC retdict{{"rows_written", ygm::sum(rows_written, m_comm)},
+             {"filename", filename}};
+  to_return = retdict;
+
+  m_comm.barrier();
+
+  return to_return;
+}
+
+}  // namespace metalldata
@@ -0,0 +1,122 @@
+// Copyright Lawrence Livermore National Security, LLC and other MetallData
+// Project Developers. See the top-level COPYRIGHT file for details.
+//
+// SPDX-License-Identifier: MIT
+
+#include <format>
+#include <map>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include <ygm/comm.hpp>
+#include <ygm/detail/collective.hpp>
+
+#include <metalldata/metall_graph.hpp>
+#include "ygm/utility/assert.hpp"
+
+namespace metalldata {
+
+namespace {
+// Rows buffered per destination rank before they are sent.
+constexpr size_t repartition_batch_rows = 1024;
+}  // namespace
+
+/**
+ * An edge is moved as one row of data_types values, one per edge series, in
+ * series index order; series are created collectively, so the order agrees
+ * across ranks.  Rows are sent per destination rank in batches of at most
+ * repartition_batch_rows.  The receiver adds a record and indexes the edge's
+ * endpoints, and the sender removes its own record, so the edge's locator
+ * changes and the adjacency indexes are invalidated.
+ */
+result<std::map<std::string, size_t>> metall_graph::repartition_edges(
+  std::string_view policy) {
+  result<std::map<std::string, size_t>> to_return;
+
+  const bool by_source = policy == "source";
+  if (!by_source && policy != "target") {
+    return std::unexpected(std::format(
+      "policy must be source or target, got {}", std::string(policy)));
+  }
+
+  const size_t num_series = m_pedges->num_series();
+  if (ygm::min(num_series, m_comm) != ygm::max(num_series, m_comm)) {
+    return std::unexpected("edge series differ across ranks");
+  }
+
+  using row_type = std::vector<data_types>;
+  auto receive = [](ygm_ptr_type pthis, const std::vector<row_type>& rows) {
+    auto& edges = *pthis->m_pedges;
+    for (const auto& row : rows) {
+      auto rid = edges.add_record();
+      for (size_t s = 0; s < row.size(); ++s) {
+        std::visit(
+          [&](const auto& val) {
+            using T = std::decay_t<decltype(val)>;
+            if constexpr (std::is_same_v<T, std::string>) {
+              edges.set(s, rid, std::string_view(val));
+            } else if constexpr (!std::is_same_v<T, std::monostate>) {
+              edges.set(s, rid, val);
+            }
+          },
+          row[s]);
+      }
+
+      // This rank may not have seen the endpoints' labels before.
+      local_edge_idx_type eid{rid};
+      auto [ulb, vlb] = pthis->pl_get_edge_uv_labels(eid);
+      auto [uloc, vloc] = pthis->pl_get_edge_uv_locators(eid);
+      pthis->priv_index_node_locator(ulb, uloc);
+      pthis->priv_index_node_locator(vlb, vloc);
+    }
+  };
+
+  std::vector<std::vector<row_type>> outgoing(m_comm.size());
+  std::vector<local_edge_idx_type>   moved;
+  priv_for_all_edges([&](local_edge_idx_type eid) {
+    auto [u, v] = pl_get_edge_uv_locators(eid);
+    auto dest = owner(by_source ? u : v);
+    // Also skips the edges received while this loop sends.
+    if (dest == m_comm.rank()) {
+      return;
+    }
+    row_type row;
+    row.reserve(num_series);
+    for (size_t s = 0; s < num_series; ++s) {
+      auto val_o = m_pedges->get_dynamic(s, std::to_underlying(eid));
+      row.push_back(val_o.has_value() ? priv_series_to_data_type(val_o.value())
+                                      : data_types{});
+    }
+    outgoing[dest].push_back(std::move(row));
+    moved.push_back(eid);
+    if (outgoing[dest].size() >= repartition_batch_rows) {
+      m_comm.async(dest, receive, pthis, outgoing[dest]);
+      outgoing[dest].clear();
+    }
+  });
+
+  for (size_t dest = 0; dest < outgoing.size(); ++dest) {
+    if (!outgoing[dest].empty()) {
+      m_comm.async(dest, receive, pthis, outgoing[dest]);
+      outgoing[dest].clear();
+    }
+  }
+  for (auto eid : moved) {
+    m_pedges->remove_record(std::to_underlying(eid));
+  }
+  m_comm.barrier();
+
+  // Endpoints and the edge set are unchanged, so the maintained analytics
+  // stay valid; only edge locators moved.
+  priv_invalidate_adjacency();
+
+  std::map<std::string, size_t> retdict{
+    {"num_edges_moved", ygm::sum(moved.size(), m_comm)}};
+  to_return = retdict;
+  return to_return;
+}
+
+}  // namespace metalldata
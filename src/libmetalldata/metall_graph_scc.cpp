@@ -0,0 +1,288 @@
+// Copyright Lawrence Livermore National Security, LLC and other MetallData
+// Project Developers. See the top-level COPYRIGHT file for details.
+//
+// SPDX-License-Identifier: MIT
+
+#include <map>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <ygm/comm.hpp>
+#include <ygm/detail/collective.hpp>
+
+#include <metalldata/metall_graph.hpp>
+#include <boost/unordered/unordered_flat_map.hpp>
+#include "ygm/utility/assert.hpp"
+
+namespace metalldata {
+
+/**
+ * Trimming + coloring (Orzan; Slota et al.).  Repeats until every node is
+ * assigned:
+ *
+ * 1. Trim: a node with no remaining in- or out-neighbors is its own
+ *    component.  Repeated until nothing more can be trimmed.
+ * 2. Color: every remaining node propagates the maximum locator forward.
+ *    The nodes whose color is their own locator are roots.
+ * 3. Backward: from each root, the nodes of the same color that reach it
+ *    along the reverse adjacency form its component.
+ *
+ * Removed nodes decrement their neighbors' remaining in/out counts; the
+ * decrements are combined per neighbor before sending.
+ */
+result<> metall_graph::strongly_connected_components(
+  const series_name& out_name, const metall_graph::where_clause& where) {
+  if (!out_name.is_node_series()) {
+    return std::unexpected(
+      std::format("invalid series name: {}", out_name.qualified()));
+  }
+
+  if (m_pnodes->contains_series(out_name.unqualified())) {
+    return std::unexpected(
+      std::format("series {} already exists", out_name.qualified()));
+  }
+
+  csr_type scratch;
+  csr_view fwd = priv_adjacency(where, scratch);
+  csr_type rscratch;
+  csr_view rev = priv_reverse_adjacency(where, fwd, rscratch);
+
+  const size_t num_slots = pl_num_node_slots();
+
+  std::vector<bool> selected(num_slots, false);
+  priv_for_all_nodes(
+    [&](local_node_idx_type nid) { selected[std::to_underlying(nid)] = true; },
+    where);
+
+  //
+  // Remaining in/out counts ignore self loops, which do not affect
+  // strong connectivity.
+  std::vector<bool>         active(selected);
+  std::vector<node_locator> scc(num_slots);
+  std::vector<int64_t>      in_count(num_slots, 0);
+  std::vector<int64_t>      out_count(num_slots, 0);
+  for (size_t i = 0; i < num_slots; ++i) {
+    local_node_idx_type nid{i};
+    auto                self = make_node_locator(m_comm.rank(), nid);
+    scc[i] = self;
+    for (auto v : fwd.neighbors(nid)) {
+      out_count[i] += (v != self);
+    }
+    for (auto u : rev.neighbors(nid)) {
+      in_count[i] += (u != self);
+    }
+  }
+
+  static std::vector<int64_t>* sp_in_count = nullptr;
+  static std::vector<int64_t>* sp_out_count = nullptr;
+  sp_in_count = &in_count;
+  sp_out_count = &out_count;
+  m_comm.barrier();
+
+  // Deactivates the given local nodes and updates their neighbors' counts.
+  boost::unordered_flat_map<node_locator, int64_t> in_dec;
+  boost::unordered_flat_map<node_locator, int64_t> out_dec;
+  auto remove = [&](const std::vector<local_node_idx_type>& removed) {
+    in_dec.clear();
+    out_dec.clear();
+    for (auto nid : removed) {
+      active[std::to_underlying(nid)] = false;
+      auto self = make_node_locator(m_comm.rank(), nid);
+      for (auto v : fwd.neighbors(nid)) {
+        if (v != self) {
+          ++in_dec[v];
+        }
+      }
+      for (auto u : rev.neighbors(nid)) {
+        if (u != self) {
+          ++out_dec[u];
+        }
+      }
+    }
+    for (const auto& [v, c] : in_dec) {
+      m_comm.async(
+        owner(v),
+        [](local_node_idx_type vid, int64_t c) {
+          (*sp_in_count)[std::to_underlying(vid)] -= c;
+        },
+        local(v), c);
+    }
+    for (const auto& [u, c] : out_dec) {
+      m_comm.async(
+        owner(u),
+        [](local_node_idx_type uid, int64_t c) {
+          (*sp_out_count)[std::to_underlying(uid)] -= c;
+        },
+        local(u), c);
+    }
+    m_comm.barrier();
+  };
+
+  // Unselected nodes only count as neighbors until they are removed.
+  {
+    std::vector<local_node_idx_type> unselected;
+    for (size_t i = 0; i < num_slots; ++i) {
+      if (!selected[i]) {
+        unselected.push_back(local_node_idx_type{i});
+      }
+    }
+    remove(unselected);
+  }
+
+  std::vector<node_locator>                             color(num_slots);
+  std::vector<bool>                                     visited(num_slots);
+  std::vector<local_node_idx_type>                      frontier;
+  std::vector<local_node_idx_type>                      next_frontier;
+  boost::unordered_flat_map<node_locator, node_locator> offers;
+  static std::vector<node_locator>*                     sp_color = nullptr;
+  static std::vector<bool>*                             sp_active = nullptr;
+  static std::vector<bool>*                             sp_visited = nullptr;
+  static std::vector<node_locator>*                     sp_scc = nullptr;
+  static std::vector<local_node_idx_type>*              sp_next = nullptr;
+  sp_color = &color;
+  sp_active = &active;
+  sp_visited = &visited;
+  sp_scc = &scc;
+  sp_next = &next_frontier;
+  m_comm.barrier();
+
+  auto offer_color = [](local_node_idx_type vid, node_locator c) {
+    auto i = std::to_underlying(vid);
+    if ((*sp_active)[i] && (*sp_color)[i] < c) {
+      (*sp_color)[i] = c;
+      if (!(*sp_visited)[i]) {
+        (*sp_visited)[i] = true;
+        sp_next->push_back(vid);
+      }
+    }
+  };
+
+  auto claim = [](local_node_idx_type wid, node_locator c) {
+    auto i = std::to_underlying(wid);
+    if ((*sp_active)[i] && !(*sp_visited)[i] && (*sp_color)[i] == c) {
+      (*sp_visited)[i] = true;
+      (*sp_scc)[i] = c;
+      sp_next->push_back(wid);
+    }
+  };
+
+  auto count_active = [&]() {
+    size_t n = 0;
+    for (bool a : active) {
+      n += a;
+    }
+    return ygm::sum(n, m_comm);
+  };
+
+  std::vector<local_node_idx_type> removed;
+  while (count_active() > 0) {
+    //
+    // 1. Trim
+    while (true) {
+      removed.clear();
+      for (size_t i = 0; i < num_slots; ++i) {
+        if (active[i] && (in_count[i] == 0 || out_count[i] == 0)) {
+          removed.push_back(local_node_idx_type{i});
+        }
+      }
+      if (ygm::sum(removed.size(), m_comm) == 0) {
+        break;
+      }
+      remove(removed);
+    }
+
+    //
+    // 2. Forward max-color propagation
+    frontier.clear();
+    for (size_t i = 0; i < num_slots; ++i) {
+      color[i] = make_node_locator(m_comm.rank(), local_node_idx_type{i});
+      if (active[i]) {
+        frontier.push_back(local_node_idx_type{i});
+      }
+    }
+    while (ygm::sum(frontier.size(), m_comm) > 0) {
+      std::fill(visited.begin(), visited.end(), false);
+      offers.clear();
+      for (auto uid : frontier) {
+        auto c = color[std::to_underlying(uid)];
+        for (auto v : fwd.neighbors(uid)) {
+          if (is_local(v)) {
+            offer_color(local(v), c);
+          } else {
+            auto [it, inserted] = offers.try_emplace(v, c);
+            if (!inserted && it->second < c) {
+              it->second = c;
+            }
+          }
+        }
+      }
+      for (const auto& [v, c] : offers) {
+        m_comm.async(owner(v), offer_color, local(v), c);
+      }
+      m_comm.barrier();
+      frontier.swap(next_frontier);
+      next_frontier.clear();
+    }
+
+    //
+    // 3. Backward reachability within each color from its root
+    std::fill(visited.begin(), visited.end(), false);
+    frontier.clear();
+    for (size_t i = 0; i < num_slots; ++i) {
+      local_node_idx_type nid{i};
+      if (active[i] && color[i] == make_node_locator(m_comm.rank(), nid)) {
+        visited[i] = true;
+        scc[i] = color[i];
+        frontier.push_back(nid);
+      }
+    }
+    removed = frontier;
+    while (ygm::sum(frontier.size(), m_comm) > 0) {
+      for (auto uid : frontier) {
+        auto c = color[std::to_underlying(uid)];
+        for (auto w : rev.neighbors(uid)) {
+          if (is_local(w)) {
+            claim(local(w), c);
+          } else {
+            m_comm.async(owner(w), claim, local(w), c);
+          }
+        }
+      }
+      m_comm.barrier();
+      removed.insert(removed.end(), next_frontier.begin(), next_frontier.end());
+      frontier.swap(next_frontier);
+      next_frontier.clear();
+    }
+    remove(removed);
+  }
+  sp_in_count = nullptr;
+  sp_out_count = nullptr;
+  sp_color = nullptr;
+  sp_active = nullptr;
+  sp_visited = nullptr;
+  sp_scc = nullptr;
+  sp_next = nullptr;
+
+  //
+  // Label each component with its root's id
+  std::set<node_locator> roots;
+  for (size_t i = 0; i < num_slots; ++i) {
+    if (selected[i]) {
+      roots.insert(scc[i]);
+    }
+  }
+  auto labels = priv_gather_node_labels(roots);
+
+  std::map<local_node_idx_type, std::string> local_scc;
+  for (size_t i = 0; i < num_slots; ++i) {
+    if (selected[i]) {
+      local_scc[local_node_idx_type{i}] = labels.at(scc[i]);
+    }
+  }
+
+  return priv_set_node_column_by_idx(out_name, local_scc);
+}
+
+}  // namespace metalldata
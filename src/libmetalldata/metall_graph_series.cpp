@@ -37,6 +37,9 @@ std::map<std::string, std::string> metall_graph::get_edge_selector_info() {
   // function) need to match the corresponding meta.json values.
   std::map<std::string, std::string> sels;
   for (const auto& el : m_pedges->get_series_names()) {
+    if (series_name("edge", el).is_internal()) {
+      continue;
+    }
     auto sel = std::format("edge.{}", el);
     sels[sel] = "default";
   }
@@ -82,11 +85,13 @@ metall_graph::pl_get_edge_uv_labels(
 std::pair<metall_graph::node_locator, metall_graph::node_locator>
 metall_graph::pl_get_edge_uv_locators(
   metall_graph::local_edge_idx_type eid) const {
-  auto [ulb, vlb] = pl_get_edge_uv_labels(eid);
-  auto uloc_o = pl_get_node_locator(ulb);
-  auto vloc_o = pl_get_node_locator(vlb);
-  YGM_ASSERT_DEBUG(uloc_o.has_value() && vloc_o.has_value());
-  return std::make_pair(uloc_o.value(), vloc_o.value());
+  auto uloc = m_pedges->get<int64_t>(std::to_underlying(m_u_loc_col_idx),
+                                     std::to_underlying(eid));
+  auto vloc = m_pedges->get<int64_t>(std::to_underlying(m_v_loc_col_idx),
+                                     std::to_underlying(eid));
+  YGM_ASSERT_DEBUG(uloc.has_value() && vloc.has_value());
+  return std::make_pair(node_locator{static_cast<size_t>(uloc.value())},
+                        node_locator{static_cast<size_t>(vloc.value())});
 }
 
 bool metall_graph::pl_edge_is_directed(
@@ -157,7 +162,10 @@ std::vector<metall_graph::series_name> metall_graph::get_edge_series_names()
   const {
   std::vector<series_name> sns;
   for (auto n : m_pedges->get_series_names()) {
-    sns.emplace_back(series_name("edge", n));
+    series_name sn("edge", n);
+    if (!sn.is_internal()) {
+      sns.emplace_back(std::move(sn));
+    }
   }
   return sns;
 };
@@ -0,0 +1,360 @@
+// Copyright Lawrence Livermore National Security, LLC and other MetallData
+// Project Developers. See the top-level COPYRIGHT file for details.
+//
+// SPDX-License-Identifier: MIT
+
+#include <algorithm>
+#include <cmath>
+#include <format>
+#include <map>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <ygm/comm.hpp>
+#include <ygm/container/bag.hpp>
+#include <ygm/detail/collective.hpp>
+
+#include <metalldata/metall_graph.hpp>
+#include <metalldata/detail/sorted_intersection.hpp>
+#include <boost/unordered/unordered_flat_map.hpp>
+#include "ygm/utility/assert.hpp"
+
+namespace metalldata {
+
+using metadata_t = std::vector<metall_graph::data_types>;
+
+/**
+ * Pairs are resolved in two steps: the owner of v sends v's locator to the
+ * owner of u, which holds the candidate.  Without pairs, every node w sends
+ * each pair (a, b) of its neighbors, a < b, to the owner of a, which keeps the
+ * distinct pairs that are not adjacent.
+ */
+result<ygm::container::bag<metadata_t>> metall_graph::pair_similarity(
+  const std::optional<std::vector<std::pair<std::string, std::string>>>&
+                      pairs,
+  const where_clause& where) {
+  result<ygm::container::bag<metadata_t>> to_return(m_comm);
+  ygm::container::bag<metadata_t>&        rows = to_return.value();
+
+  csr_type undirected;
+  priv_undirected_adjacency(where, undirected);
+  csr_view und = undirected.view();
+
+  std::vector<similarity_candidate> candidates;
+  if (pairs.has_value()) {
+    const auto&                              ps = pairs.value();
+    std::vector<std::optional<node_locator>> v_locs(ps.size());
+    static std::vector<std::optional<node_locator>>* sp_v_locs = nullptr;
+    sp_v_locs = &v_locs;
+    m_comm.barrier();
+
+    for (size_t i = 0; i < ps.size(); ++i) {
+      const auto& [u, v] = ps[i];
+      if (m_partitioner.owner(v) != m_comm.rank()) {
+        continue;
+      }
+      auto nid_o = pl_get_node_id(v);
+      if (nid_o.has_value()) {
+        m_comm.async(
+          m_partitioner.owner(u),
+          [](size_t i, node_locator vloc) { (*sp_v_locs)[i] = vloc; }, i,
+          make_node_locator(m_comm.rank(), nid_o.value()));
+      }
+    }
+    m_comm.barrier();
+    sp_v_locs = nullptr;
+
+    size_t missing = 0;
+    for (size_t i = 0; i < ps.size(); ++i) {
+      if (m_partitioner.owner(ps[i].first) != m_comm.rank()) {
+        continue;
+      }
+      auto nid_o = pl_get_node_id(ps[i].first);
+      if (!nid_o.has_value() || !v_locs[i].has_value()) {
+        ++missing;
+        continue;
+      }
+      candidates.emplace_back(nid_o.value(), v_locs[i].value(),
+                              edge_locator{});
+    }
+    missing = ygm::sum(missing, m_comm);
+    if (missing > 0) {
+      to_return.add_warnings(missing, "pairs with missing nodes");
+    }
+  } else {
+    //
+    // All pairs at distance two.
+    using wedge = std::pair<local_node_idx_type, node_locator>;
+    std::vector<wedge>         wedges;
+    static std::vector<wedge>* sp_wedges = nullptr;
+    sp_wedges = &wedges;
+    m_comm.barrier();
+
+    auto receive = [](const std::vector<wedge>& ws) {
+      sp_wedges->insert(sp_wedges->end(), ws.begin(), ws.end());
+    };
+
+    std::vector<std::vector<wedge>> outgoing(m_comm.size());
+    for (size_t i = 0; i < und.num_rows(); ++i) {
+      auto nbrs = und.neighbors(local_node_idx_type{i});
+      for (size_t j = 0; j < nbrs.size(); ++j) {
+        for (size_t k = j + 1; k < nbrs.size(); ++k) {
+          auto a = nbrs[j];
+          if (is_local(a)) {
+            wedges.emplace_back(local(a), nbrs[k]);
+          } else {
+            outgoing[owner(a)].emplace_back(local(a), nbrs[k]);
+          }
+        }
+      }
+      for (size_t dest = 0; dest < outgoing.size(); ++dest) {
+        if (!outgoing[dest].empty()) {
+          m_comm.async(dest, receive, outgoing[dest]);
+          outgoing[dest].clear();
+        }
+      }
+    }
+    m_comm.barrier();
+    sp_wedges = nullptr;
+
+    std::sort(wedges.begin(), wedges.end());
+    wedges.erase(std::unique(wedges.begin(), wedges.end()), wedges.end());
+    for (const auto& [a, b] : wedges) {
+      auto nbrs = und.neighbors(a);
+      if (!std::binary_search(nbrs.begin(), nbrs.end(), b)) {
+        candidates.emplace_back(a, b, edge_locator{});
+      }
+    }
+  }
+
+  for (const auto& [ulabel, vid, tag, common, jaccard, adamic_adar] :
+       priv_pair_similarity(und, candidates)) {
+    rows.local_insert(metadata_t{ulabel, std::string(pl_get_node_label(vid)),
+                                 common, jaccard, adamic_adar});
+  }
+  m_comm.barrier();
+  return to_return;
+}
+
+result<> metall_graph::edge_similarity(
+  const std::optional<series_name>& out_common,
+  const std::optional<series_name>& out_jaccard,
+  const std::optional<series_name>& out_adamic_adar,
+  const where_clause&               where) {
+  std::vector<series_name> outs;
+  for (const auto* sn : {&out_common, &out_jaccard, &out_adamic_adar}) {
+    if (!sn->has_value()) {
+      continue;
+    }
+    if (!sn->value().is_edge_series() || sn->value().is_reserved()) {
+      return std::unexpected(
+        std::format("invalid series name: {}", sn->value().qualified()));
+    }
+    if (m_pedges->contains_series(sn->value().unqualified())) {
+      return std::unexpected(
+        std::format("series {} already exists", sn->value().qualified()));
+    }
+    if (std::ranges::find(outs, sn->value()) != outs.end()) {
+      return std::unexpected(std::format(
+        "series {} is used by more than one output", sn->value().qualified()));
+    }
+    outs.push_back(sn->value());
+  }
+  if (outs.empty()) {
+    return std::unexpected("no output series given");
+  }
+
+  csr_type undirected;
+  priv_undirected_adjacency(where, undirected);
+
+  //
+  // Every selected edge becomes a candidate at the owner of u.
+  std::vector<similarity_candidate>         candidates;
+  static std::vector<similarity_candidate>* sp_candidates = nullptr;
+  sp_candidates = &candidates;
+  m_comm.barrier();
+  priv_for_all_edges(
+    [&](local_edge_idx_type eid) {
+      auto [u, v] = pl_get_edge_uv_locators(eid);
+      m_comm.async(
+        owner(u),
+        [](local_node_idx_type uid, node_locator v, edge_locator e) {
+          sp_candidates->emplace_back(uid, v, e);
+        },
+        local(u), v, make_edge_locator(m_comm.rank(), eid));
+    },
+    where);
+  m_comm.barrier();
+  sp_candidates = nullptr;
+
+  auto rows = priv_pair_similarity(undirected.view(), candidates);
+  candidates.clear();
+
+  static std::optional<size_t> s_common_idx;
+  static std::optional<size_t> s_jaccard_idx;
+  static std::optional<size_t> s_adamic_adar_idx;
+  s_common_idx.reset();
+  s_jaccard_idx.reset();
+  s_adamic_adar_idx.reset();
+  if (out_common.has_value()) {
+    s_common_idx =
+      m_pedges->add_series<int64_t>(out_common.value().unqualified());
+  }
+  if (out_jaccard.has_value()) {
+    s_jaccard_idx =
+      m_pedges->add_series<double>(out_jaccard.value().unqualified());
+  }
+  if (out_adamic_adar.has_value()) {
+    s_adamic_adar_idx =
+      m_pedges->add_series<double>(out_adamic_adar.value().unqualified());
+  }
+  m_comm.barrier();
+
+  auto store = [](ygm_ptr_type pthis, local_edge_idx_type eid, int64_t common,
+                  double jaccard, double adamic_adar) {
+    auto& edges = *pthis->m_pedges;
+    auto  rid = std::to_underlying(eid);
+    if (s_common_idx.has_value()) {
+      edges.set(s_common_idx.value(), rid, common);
+    }
+    if (s_jaccard_idx.has_value()) {
+      edges.set(s_jaccard_idx.value(), rid, jaccard);
+    }
+    if (s_adamic_adar_idx.has_value()) {
+      edges.set(s_adamic_adar_idx.value(), rid, adamic_adar);
+    }
+  };
+  for (const auto& [ulabel, vid, e, common, jaccard, adamic_adar] : rows) {
+    if (is_local(e)) {
+      store(pthis, local(e), common, jaccard, adamic_adar);
+    } else {
+      m_comm.async(owner(e), store, pthis, local(e), common, jaccard,
+                   adamic_adar);
+    }
+  }
+  m_comm.barrier();
+  s_common_idx.reset();
+  s_jaccard_idx.reset();
+  s_adamic_adar_idx.reset();
+
+  return {};
+}
+
+/**
+ * For each u, N(u) is shipped once per rank owning one of u's candidate
+ * partners, together with those partners, and intersected there with N(v).
+ * Adamic-Adar needs the degree of every common neighbor w; w is a neighbor of
+ * v, so the owner of v gathers the degrees of its remote neighbors up front,
+ * as priv_triangle_counts() does.
+ */
+std::vector<metall_graph::similarity_row> metall_graph::priv_pair_similarity(
+  csr_view und, const std::vector<similarity_candidate>& candidates) {
+  std::vector<int64_t> deg(pl_num_node_slots(), 0);
+  for (size_t i = 0; i < deg.size(); ++i) {
+    deg[i] = static_cast<int64_t>(und.degree(local_node_idx_type{i}));
+  }
+
+  boost::unordered_flat_map<node_locator, int64_t>         nbr_deg;
+  static boost::unordered_flat_map<node_locator, int64_t>* sp_nbr_deg =
+    nullptr;
+  static std::vector<int64_t>* sp_deg = nullptr;
+  sp_nbr_deg = &nbr_deg;
+  sp_deg = &deg;
+  m_comm.barrier();
+  for (size_t i = 0; i < und.num_rows(); ++i) {
+    for (auto w : und.neighbors(local_node_idx_type{i})) {
+      if (!is_local(w)) {
+        nbr_deg.try_emplace(w, 0);
+      }
+    }
+  }
+  for (const auto& [w, unused] : nbr_deg) {
+    m_comm.async(
+      owner(w),
+      [](ygm_ptr_type pthis, local_node_idx_type wid, int requesting_rank) {
+        auto wloc = make_node_locator(pthis->m_comm.rank(), wid);
+        pthis->m_comm.async(
+          requesting_rank,
+          [](node_locator w, int64_t d) { (*sp_nbr_deg)[w] = d; }, wloc,
+          (*sp_deg)[std::to_underlying(wid)]);
+      },
+      pthis, local(w), m_comm.rank());
+  }
+  m_comm.barrier();
+
+  std::vector<similarity_row>         rows;
+  static std::vector<similarity_row>* sp_rows = nullptr;
+  static csr_view                     s_und;
+  sp_rows = &rows;
+  s_und = und;
+  m_comm.barrier();
+
+  using partner = std::pair<local_node_idx_type, edge_locator>;
+  auto intersect = [](ygm_ptr_type pthis, const std::string& ulabel,
+                      const std::vector<node_locator>& nbrs_u,
+                      const std::vector<partner>&      vs) {
+    auto degree_of = [&](node_locator w) {
+      return owner(w) == pthis->m_comm.rank()
+               ? (*sp_deg)[std::to_underlying(local(w))]
+               : sp_nbr_deg->at(w);
+    };
+    for (const auto& [vid, tag] : vs) {
+      auto    nbrs_v = s_und.neighbors(vid);
+      int64_t common = 0;
+      double  adamic_adar = 0.0;
+      for_each_common<node_locator>(nbrs_u, nbrs_v, [&](node_locator w) {
+        ++common;
+        auto d = degree_of(w);
+        if (d > 1) {
+          adamic_adar += 1.0 / std::log(double(d));
+        }
+      });
+      auto   num_union = int64_t(nbrs_u.size() + nbrs_v.size()) - common;
+      double jaccard = num_union == 0 ? 0.0 : double(common) / num_union;
+      sp_rows->emplace_back(ulabel, vid, tag, common, jaccard, adamic_adar);
+    }
+  };
+
+  //
+  // Candidates grouped by u, then by the owner of v.
+  std::vector<similarity_candidate> sorted(candidates);
+  std::sort(sorted.begin(), sorted.end(),
+            [](const similarity_candidate& a, const similarity_candidate& b) {
+              return std::make_pair(std::get<0>(a), owner(std::get<1>(a))) <
+                     std::make_pair(std::get<0>(b), owner(std::get<1>(b)));
+            });
+  std::map<int, std::vector<partner>> by_rank;
+  std::vector<node_locator>           nbrs_u;
+  for (size_t first = 0; first < sorted.size();) {
+    auto   uid = std::get<0>(sorted[first]);
+    size_t last = first;
+    by_rank.clear();
+    for (; last < sorted.size() && std::get<0>(sorted[last]) == uid; ++last) {
+      const auto& [u, v, tag] = sorted[last];
+      by_rank[owner(v)].emplace_back(local(v), tag);
+    }
+    auto nbrs = und.neighbors(uid);
+    nbrs_u.assign(nbrs.begin(), nbrs.end());
+    std::string ulabel(pl_get_node_label(uid));
+    for (const auto& [dest, vs] : by_rank) {
+      if (dest == m_comm.rank()) {
+        intersect(pthis, ulabel, nbrs_u, vs);
+      } else {
+        m_comm.async(dest, intersect, pthis, ulabel, nbrs_u, vs);
+      }
+    }
+    first = last;
+  }
+  m_comm.barrier();
+  sp_rows = nullptr;
+  s_und = csr_view{};
+  sp_nbr_deg = nullptr;
+  sp_deg = nullptr;
+
+  return rows;
+}
+
+}  // namespace metalldata
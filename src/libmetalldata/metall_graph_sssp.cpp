@@ -0,0 +1,313 @@
+// Copyright Lawrence Livermore National Security, LLC and other MetallData
+// Project Developers. See the top-level COPYRIGHT file for details.
+//
+// SPDX-License-Identifier: MIT
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <ygm/comm.hpp>
+#include <ygm/detail/collective.hpp>
+
+#include <metalldata/metall_graph.hpp>
+#include <boost/unordered/unordered_flat_map.hpp>
+#include "ygm/utility/assert.hpp"
+
+namespace metalldata {
+
+/**
+ * @brief Distributed delta-stepping (Meyer & Sanders).
+ *
+ * Weighted out-edges are staged at the owner of their source, sorted by
+ * weight so that every row splits into a light (w <= delta) prefix and a
+ * heavy suffix.  Tentative distances live in buckets of width delta.  The
+ * smallest non-empty bucket is settled by relaxing light edges until it stays
+ * empty, then heavy edges once from every node it settled.  Relaxations of
+ * one round are reduced to the smallest distance per target and sent as one
+ * message per destination rank.
+ */
+result<> metall_graph::sssp(const series_name&              out_name,
+                            const series_name&              weight_name,
+                            const std::vector<std::string>& sources,
+                            double max_dist, const where_clause& where) {
+  if (!out_name.is_node_series()) {
+    return std::unexpected(
+      std::format("invalid series name: {}", out_name.qualified()));
+  }
+
+  if (m_pnodes->contains_series(out_name.unqualified())) {
+    return std::unexpected(
+      std::format("series {} already exists", out_name.qualified()));
+  }
+
+  if (!weight_name.is_edge_series()) {
+    return std::unexpected(
+      std::format("invalid edge series name: {}", weight_name.qualified()));
+  }
+
+  auto wid_o = pl_find_edge_series(weight_name);
+  if (!wid_o.has_value()) {
+    return std::unexpected(
+      std::format("series {} not found", weight_name.qualified()));
+  }
+  auto wid = wid_o.value();
+  if (!priv_is_edge_series_type<double>(wid) &&
+      !priv_is_edge_series_type<int64_t>(wid)) {
+    return std::unexpected(std::format("series {} must be double or int64",
+                                       weight_name.qualified()));
+  }
+
+  using weighted_entry = std::tuple<local_node_idx_type, double, node_locator>;
+
+  //
+  // Weighted adjacency, staged at the owner of each row.  Edges without a
+  // weight are skipped; negative weights are an error.
+  std::vector<weighted_entry>         staged;
+  static std::vector<weighted_entry>* sp_staged = nullptr;
+  sp_staged = &staged;
+  m_comm.barrier();
+
+  auto stage = [](local_node_idx_type row, double w, node_locator nbr) {
+    sp_staged->emplace_back(row, w, nbr);
+  };
+
+  size_t local_unweighted = 0;
+  bool   local_negative = false;
+  double local_weight_sum = 0.0;
+  size_t local_weighted = 0;
+  priv_for_all_edges(
+    [&](local_edge_idx_type eid) {
+      std::optional<double> w_o;
+      if (auto d_o = pl_get_edge_field<double>(wid, eid); d_o.has_value()) {
+        w_o = d_o.value();
+      } else if (auto i_o = pl_get_edge_field<int64_t>(wid, eid);
+                 i_o.has_value()) {
+        w_o = double(i_o.value());
+      }
+      if (!w_o.has_value() || std::isnan(w_o.value())) {
+        ++local_unweighted;
+        return;
+      }
+      double w = w_o.value();
+      if (w < 0.0) {
+        local_negative = true;
+        return;
+      }
+      local_weight_sum += w;
+      ++local_weighted;
+      auto [u, v] = pl_get_edge_uv_locators(eid);
+      m_comm.async(owner(u), stage, local(u), w, v);
+      if (!pl_edge_is_directed(eid)) {
+        m_comm.async(owner(v), stage, local(v), w, u);
+      }
+    },
+    where);
+  m_comm.barrier();
+  sp_staged = nullptr;
+
+  if (ygm::logical_or(local_negative, m_comm)) {
+    return std::unexpected(std::format("series {} has negative weights",
+                                       weight_name.qualified()));
+  }
+
+  const size_t num_slots = pl_num_node_slots();
+  std::sort(staged.begin(), staged.end());
+  std::vector<size_t> offsets(num_slots + 1, 0);
+  for (const auto& e : staged) {
+    ++offsets[std::to_underlying(std::get<0>(e)) + 1];
+  }
+  for (size_t i = 0; i < num_slots; ++i) {
+    offsets[i + 1] += offsets[i];
+  }
+
+  //
+  // delta is the mean edge weight; zero-weight graphs use 1.
+  size_t num_weighted = ygm::sum(local_weighted, m_comm);
+  double delta = num_weighted == 0
+                   ? 1.0
+                   : ygm::sum(local_weight_sum, m_comm) / double(num_weighted);
+  if (!(delta > 0.0)) {
+    delta = 1.0;
+  }
+
+  // First entry of row i that is heavy
+  std::vector<size_t> heavy_begin(num_slots, 0);
+  for (size_t i = 0; i < num_slots; ++i) {
+    auto first = staged.begin() + offsets[i];
+    auto last = staged.begin() + offsets[i + 1];
+    heavy_begin[i] = std::partition_point(first, last,
+                                          [&](const weighted_entry& e) {
+                                            return std::get<1>(e) <= delta;
+                                          }) -
+                     staged.begin();
+  }
+
+  //
+  // Sources are resolved by the rank that owns them.
+  std::vector<local_node_idx_type> local_sources;
+  std::vector<std::string>         missing_vertices;
+  for (const auto& source : sources) {
+    bool missing = false;
+    if (m_partitioner.owner(source) == m_comm.rank()) {
+      auto nid_o = pl_get_node_id(source);
+      if (nid_o.has_value()) {
+        local_sources.push_back(nid_o.value());
+      } else {
+        missing = true;
+      }
+    }
+    if (ygm::logical_or(missing, m_comm)) {
+      missing_vertices.push_back(source);
+    }
+  }
+  if (!missing_vertices.empty()) {
+    std::string error = "source vertex/vertices invalid or missing: ";
+    for (size_t i = 0; i < missing_vertices.size(); ++i) {
+      if (i > 0) error += ", ";
+      error += missing_vertices[i];
+    }
+    return std::unexpected(error);
+  }
+
+  constexpr size_t no_bucket = std::numeric_limits<size_t>::max();
+  const double     inf = std::numeric_limits<double>::infinity();
+
+  std::vector<double> dist(num_slots, inf);
+  // Bucket each node is currently queued in; stale queue entries are skipped.
+  std::vector<size_t> node_bucket(num_slots, no_bucket);
+  std::map<size_t, std::vector<local_node_idx_type>> buckets;
+
+  static std::vector<double>* sp_dist = nullptr;
+  static std::vector<size_t>* sp_node_bucket = nullptr;
+  static std::map<size_t, std::vector<local_node_idx_type>>* sp_buckets =
+    nullptr;
+  static double s_delta = 1.0;
+  static double s_max_dist = 0.0;
+  sp_dist = &dist;
+  sp_node_bucket = &node_bucket;
+  sp_buckets = &buckets;
+  s_delta = delta;
+  s_max_dist = max_dist;
+  m_comm.barrier();
+
+  static constexpr auto relax = [](local_node_idx_type vid, double d) {
+    auto i = std::to_underlying(vid);
+    if (d < (*sp_dist)[i] && d <= s_max_dist) {
+      (*sp_dist)[i] = d;
+      auto b = static_cast<size_t>(d / s_delta);
+      if ((*sp_node_bucket)[i] != b) {
+        (*sp_node_bucket)[i] = b;
+        (*sp_buckets)[b].push_back(vid);
+      }
+    }
+  };
+
+  using update = std::pair<local_node_idx_type, double>;
+  auto receive = [](const std::vector<update>& updates) {
+    for (const auto& [vid, d] : updates) {
+      relax(vid, d);
+    }
+  };
+
+  for (auto nid : local_sources) {
+    relax(nid, 0.0);
+  }
+
+  //
+  // Relaxes entries [begin(u), end(u)) of every row in us, keeping only the
+  // smallest distance per remote target before sending.
+  boost::unordered_flat_map<node_locator, double> best;
+  std::vector<std::vector<update>>                outgoing(m_comm.size());
+  auto relax_rows = [&](const std::vector<local_node_idx_type>& us,
+                        bool                                    heavy) {
+    best.clear();
+    for (auto uid : us) {
+      auto i = std::to_underlying(uid);
+      auto first = heavy ? heavy_begin[i] : offsets[i];
+      auto last = heavy ? offsets[i + 1] : heavy_begin[i];
+      for (size_t j = first; j < last; ++j) {
+        const auto& [row, w, v] = staged[j];
+        double      d = dist[i] + w;
+        if (d > max_dist) {
+          // Rows are sorted by weight
+          break;
+        }
+        if (is_local(v)) {
+          relax(local(v), d);
+        } else {
+          auto [it, inserted] = best.try_emplace(v, d);
+          if (!inserted && d < it->second) {
+            it->second = d;
+          }
+        }
+      }
+    }
+    for (const auto& [v, d] : best) {
+      outgoing[owner(v)].emplace_back(local(v), d);
+    }
+    for (size_t dest = 0; dest < outgoing.size(); ++dest) {
+      if (!outgoing[dest].empty()) {
+        m_comm.async(dest, receive, outgoing[dest]);
+        outgoing[dest].clear();
+      }
+    }
+    m_comm.barrier();
+  };
+
+  std::vector<local_node_idx_type> frontier;
+  std::vector<local_node_idx_type> settled;
+  while (true) {
+    size_t local_min = buckets.empty() ? no_bucket : buckets.begin()->first;
+    size_t cur = ygm::min(local_min, m_comm);
+    if (cur == no_bucket) {
+      break;
+    }
+
+    settled.clear();
+    while (ygm::logical_or(buckets.contains(cur), m_comm)) {
+      frontier.clear();
+      if (auto it = buckets.find(cur); it != buckets.end()) {
+        for (auto nid : it->second) {
+          auto i = std::to_underlying(nid);
+          if (node_bucket[i] == cur) {
+            node_bucket[i] = no_bucket;
+            frontier.push_back(nid);
+          }
+        }
+        buckets.erase(it);
+      }
+      settled.insert(settled.end(), frontier.begin(), frontier.end());
+      relax_rows(frontier, false);
+    }
+
+    std::sort(settled.begin(), settled.end());
+    settled.erase(std::unique(settled.begin(), settled.end()), settled.end());
+    relax_rows(settled, true);
+  }
+  sp_dist = nullptr;
+  sp_node_bucket = nullptr;
+  sp_buckets = nullptr;
+
+  std::map<local_node_idx_type, double> local_dist;
+  for (size_t i = 0; i < dist.size(); ++i) {
+    if (dist[i] < inf) {
+      local_dist[local_node_idx_type{i}] = dist[i];
+    }
+  }
+
+  auto to_return = priv_set_node_column_by_idx(out_name, local_dist);
+  size_t unweighted = ygm::sum(local_unweighted, m_comm);
+  if (to_return.has_value() && unweighted > 0) {
+    to_return.add_warnings(unweighted, "edges without a weight");
+  }
+  return to_return;
+}
+
+}  // namespace metalldata
@@ -0,0 +1,35 @@
+# Copyright Lawrence Livermore National Security, LLC and other MetallData
+# Project Developers. See the top-level COPYRIGHT file for details.
+#
+# SPDX-License-Identifier: MIT
+
+import pytest
+from clippy.backends.fs.execution import NonZeroReturnCodeError  # type: ignore
+
+
+def test_mg_aggregate_to_nodes(metallgraph):
+    metallgraph.assign("edge.w", 2)
+    metallgraph.aggregate_to_nodes("w", "wsum", agg="sum", direction="out")
+    metallgraph.aggregate_to_nodes("w", "wmean", agg="mean", direction="in")
+    metallgraph.aggregate_to_nodes("w", "cnt", agg="count", direction="both")
+    metallgraph.out_degree("outdeg")
+    metallgraph.in_degree("din")
+    metallgraph.out_degree("dout")
+
+    by_id = {d["node.id"]: d for d in metallgraph.select_nodes()}
+    assert by_id["5clique-a"]["node.wsum"] == 8
+    assert "node.wsum" not in by_id["5clique-e"]
+    assert by_id["5clique-e"]["node.wmean"] == pytest.approx(2.0)
+    assert "node.wmean" not in by_id["5clique-a"]
+    for d in by_id.values():
+        if "node.wsum" in d:
+            assert d["node.wsum"] == 2 * d["node.outdeg"]
+        assert d["node.cnt"] == d["node.din"] + d["node.dout"]
+
+
+def test_mg_aggregate_to_nodes_errors(metallgraph):
+    metallgraph.assign("edge.w", 2)
+    with pytest.raises(NonZeroReturnCodeError):
+        metallgraph.aggregate_to_nodes("w", "bad", agg="median")
+    with pytest.raises(NonZeroReturnCodeError):
+        metallgraph.aggregate_to_nodes("w", "bad", direction="sideways")
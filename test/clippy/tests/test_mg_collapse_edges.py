@@ -0,0 +1,56 @@
+# Copyright Lawrence Livermore National Security, LLC and other MetallData
+# Project Developers. See the top-level COPYRIGHT file for details.
+#
+# SPDX-License-Identifier: MIT
+
+import pytest
+from clippy.backends.fs.execution import NonZeroReturnCodeError  # type: ignore
+from conftest import DATA_DIR, is_as_described
+
+
+def test_mg_collapse_edges(metallgraph):
+    before = metallgraph.describe()
+    # Ingesting the same edges again makes every edge a parallel pair.
+    metallgraph.ingest_parquet_edges(DATA_DIR + "/test", "s", "t")
+    is_as_described(metallgraph, before["nv"], 2 * before["ne"])
+
+    r = metallgraph.collapse_edges(
+        aggs={
+            "n": ["count"],
+            "gsum": ["sum", "graphnum"],
+            "gmax": ["max", "graphnum"],
+            "graphnum": ["first"],
+        }
+    )
+    assert r["num_groups"] == before["ne"]
+    assert r["num_edges_removed"] == before["ne"]
+    is_as_described(metallgraph, before["nv"], before["ne"])
+
+    for d in metallgraph.select_edges():
+        assert d["edge.n"] == 2
+        assert d["edge.gsum"] == 2 * d["edge.graphnum"]
+        assert d["edge.gmax"] == d["edge.graphnum"]
+
+
+def test_mg_collapse_edges_where(metallgraph):
+    before = metallgraph.describe()
+    metallgraph.ingest_parquet_edges(DATA_DIR + "/test", "s", "t")
+
+    where = metallgraph.edge.graphnum == 3
+    n3 = metallgraph.describe(where=where)["ne"]
+    metallgraph.collapse_edges(aggs={"n": ["count"]}, where=where)
+    is_as_described(metallgraph, before["nv"], 2 * before["ne"] - n3 // 2)
+
+
+def test_mg_collapse_edges_invalid(metallgraph):
+    before = metallgraph.describe()
+    metallgraph.ingest_parquet_edges(DATA_DIR + "/test", "s", "t")
+
+    # A bad aggregation fails before any output series is created.
+    with pytest.raises(NonZeroReturnCodeError):
+        metallgraph.collapse_edges(
+            aggs={"n": ["count"], "gmed": ["median", "graphnum"]}
+        )
+    is_as_described(metallgraph, before["nv"], 2 * before["ne"])
+    for d in metallgraph.select_edges():
+        assert "edge.n" not in d
@@ -0,0 +1,35 @@
+# Copyright Lawrence Livermore National Security, LLC and other MetallData
+# Project Developers. See the top-level COPYRIGHT file for details.
+#
+# SPDX-License-Identifier: MIT
+
+from conftest import is_as_described
+
+
+def edge_rows(mg):
+    return sorted(
+        (d["edge.u"], d["edge.v"], d.get("edge.graphnum"))
+        for d in mg.select_edges(limit=0)
+    )
+
+
+def test_mg_compact(metallgraph):
+    metallgraph.erase_edges(where=metallgraph.edge.u == "path-c")
+    after_erase = metallgraph.describe()
+    rows = edge_rows(metallgraph)
+    metallgraph.out_degree("out1")
+
+    r = metallgraph.compact()
+    assert r["num_edge_slots_removed"] > 0
+    assert r["num_node_slots_removed"] == 0
+    assert r["bytes_reclaimed"] > 0
+    is_as_described(metallgraph, after_erase["nv"], after_erase["ne"])
+    assert edge_rows(metallgraph) == rows
+
+    # Nothing left to reclaim; the rebuilt indexes agree.
+    r = metallgraph.compact()
+    assert r["num_edge_slots_removed"] == 0
+    assert r["bytes_reclaimed"] == 0
+    metallgraph.out_degree("out2")
+    for d in metallgraph.select_nodes():
+        assert d["node.out1"] == d["node.out2"]
@@ -34,3 +34,25 @@ def test_mg_cc_where(metallgraph):
     # Exclude destination-only nodes that get no cc in directed graphs
     cc_vals = {d["node.cc"] for d in select_data}
     assert len(cc_vals) == 1
+
+
+def test_mg_cc_label_is_member(metallgraph):
+    # Components are labeled by one of their own nodes.
+    metallgraph.connected_components("cc")
+    select_data = metallgraph.select_nodes()
+    cc_by_id = {d["node.id"]: d["node.cc"] for d in select_data}
+
+    for node_id, label in cc_by_id.items():
+        assert label in cc_by_id
+        assert cc_by_id[label] == label
+
+
+def test_mg_cc_sink_nodes(metallgraph):
+    # Nodes with no out edges still get the label of their component.
+    metallgraph.connected_components("cc")
+    cc_by_id = {d["node.id"]: d.get("node.cc") for d in metallgraph.select_nodes()}
+
+    assert cc_by_id["path-g"] is not None
+    assert cc_by_id["path-g"] == cc_by_id["path-a"]
+    assert cc_by_id["5clique-e"] is not None
+    assert cc_by_id["5clique-e"] == cc_by_id["5clique-a"]
@@ -3,7 +3,7 @@
 #
 # SPDX-License-Identifier: MIT
 
-from conftest import is_specific
+from conftest import DATA_DIR, is_specific
 
 
 def test_mg_indegree(metallgraph):
@@ -48,3 +48,19 @@ def test_mg_outdegree(metallgraph):
     metallgraph.out_degree("outdeg2", where=metallgraph.node.outdeg1 > 2)
     select_data = metallgraph.select_nodes()
     is_specific(select_data, "id", degs2)
+
+
+def test_mg_degree_cache_refreshed_by_ingest(metallgraph):
+    metallgraph.in_degree("in1")
+    metallgraph.out_degree("out1")
+    metallgraph.out_degree("out2")
+
+    # Every edge again: the cached degrees must not be reused.
+    metallgraph.ingest_parquet_edges(DATA_DIR + "/test", "s", "t")
+    metallgraph.in_degree("in3")
+    metallgraph.out_degree("out3")
+
+    for d in metallgraph.select_nodes():
+        assert d["node.out1"] == d["node.out2"]
+        assert d["node.in3"] == 2 * d["node.in1"]
+        assert d["node.out3"] == 2 * d["node.out1"]
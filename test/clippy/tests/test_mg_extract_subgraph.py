@@ -0,0 +1,42 @@
+# Copyright Lawrence Livermore National Security, LLC and other MetallData
+# Project Developers. See the top-level COPYRIGHT file for details.
+#
+# SPDX-License-Identifier: MIT
+
+from clippy import MetallGraph  # type: ignore
+from conftest import is_as_described, is_as_selected
+
+
+def test_mg_extract_subgraph(metallgraph, tmp_path):
+    dest = str(tmp_path / "extracted.db")
+    where = metallgraph.edge.graphnum == 3
+    expected = metallgraph.describe(where=where)
+
+    r = metallgraph.extract_subgraph(dest, where=where)
+    assert r["num_nodes"] == expected["nv"]
+    assert r["num_edges"] == expected["ne"]
+
+    extracted = MetallGraph(dest)
+    is_as_described(extracted, expected["nv"], expected["ne"], False)
+
+    # All series come along by default, and the copy is traversable.
+    select_data = extracted.select_nodes()
+    is_as_selected(select_data, {"node.gnum": 3}, ["node.id"], [])
+    select_data = extracted.select_edges()
+    is_as_selected(select_data, {"edge.graphnum": 3}, ["edge.u", "edge.v"], [])
+    extracted.connected_components("cc")
+
+
+def test_mg_extract_subgraph_series(metallgraph, tmp_path):
+    dest = str(tmp_path / "extracted.db")
+    metallgraph.extract_subgraph(dest, series=["edge.graphnum"])
+
+    extracted = MetallGraph(dest)
+    is_as_described(
+        extracted,
+        metallgraph.describe()["nv"],
+        metallgraph.describe()["ne"],
+        False,
+    )
+    select_data = extracted.select_nodes()
+    is_as_selected(select_data, {}, ["node.id"], ["node.gnum"])
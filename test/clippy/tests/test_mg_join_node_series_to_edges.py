@@ -0,0 +1,19 @@
+# Copyright Lawrence Livermore National Security, LLC and other MetallData
+# Project Developers. See the top-level COPYRIGHT file for details.
+#
+# SPDX-License-Identifier: MIT
+
+
+def test_mg_join_node_series_to_edges(metallgraph):
+    metallgraph.out_degree("outdeg")
+    metallgraph.join_node_series_to_edges("outdeg")
+    metallgraph.join_node_series_to_edges("id", endpoint="v", output="vid")
+
+    outdeg = {d["node.id"]: d["node.outdeg"] for d in metallgraph.select_nodes()}
+    for d in metallgraph.select_edges():
+        assert d["edge.u_outdeg"] == outdeg[d["edge.u"]]
+        assert d["edge.vid"] == d["edge.v"]
+
+    # Joined series can be used in edge where clauses directly.
+    n = metallgraph.describe(where=metallgraph.edge.u_outdeg >= 4)["ne"]
+    assert n > 0
@@ -0,0 +1,25 @@
+# Copyright Lawrence Livermore National Security, LLC and other MetallData
+# Project Developers. See the top-level COPYRIGHT file for details.
+#
+# SPDX-License-Identifier: MIT
+
+
+def test_mg_kcore(metallgraph):
+    metallgraph.kcore("core")
+    select_data = metallgraph.select_nodes()
+    core_by_id = {d["node.id"]: d["node.core"] for d in select_data}
+
+    for c in "abcde":
+        assert core_by_id[f"5clique-{c}"] == 4
+    for c in "abcdefg":
+        assert core_by_id[f"path-{c}"] == 1
+
+
+def test_mg_kcore_where(metallgraph):
+    # Dropping one clique node leaves a 4-clique, i.e. a 3-core.
+    metallgraph.kcore("core", where=metallgraph.edge.u != "5clique-a")
+    select_data = metallgraph.select_nodes()
+    core_by_id = {d["node.id"]: d.get("node.core") for d in select_data}
+
+    for c in "bcde":
+        assert core_by_id[f"5clique-{c}"] == 3
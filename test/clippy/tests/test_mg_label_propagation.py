@@ -0,0 +1,31 @@
+# Copyright Lawrence Livermore National Security, LLC and other MetallData
+# Project Developers. See the top-level COPYRIGHT file for details.
+#
+# SPDX-License-Identifier: MIT
+
+
+def test_mg_label_propagation(metallgraph):
+    metallgraph.label_propagation("lpa")
+    select_data = metallgraph.select_nodes()
+    lpa_by_id = {d["node.id"]: d["node.lpa"] for d in select_data}
+
+    assert all(isinstance(l, int) for l in lpa_by_id.values())
+    clique_labels = {lpa_by_id[f"5clique-{c}"] for c in "abcde"}
+    assert len(clique_labels) == 1
+    path_labels = {lpa_by_id[f"path-{c}"] for c in "abcdefg"}
+    # Communities never span components.
+    assert path_labels.isdisjoint(clique_labels)
+
+
+def test_mg_label_propagation_two_nodes(metallgraph):
+    # The only edge out of path-a leaves a two-node component, which settles
+    # on one label instead of swapping forever.
+    where = metallgraph.edge.u == "path-a"
+    r = metallgraph.label_propagation("lpa2", max_iters=50, where=where)
+    assert r["converged"] == 1
+    assert r["num_iterations"] < 50
+
+    lpa_by_id = {
+        d["node.id"]: d.get("node.lpa2") for d in metallgraph.select_nodes()
+    }
+    assert lpa_by_id["path-a"] == lpa_by_id["path-b"]
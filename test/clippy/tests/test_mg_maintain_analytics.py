@@ -0,0 +1,40 @@
+# Copyright Lawrence Livermore National Security, LLC and other MetallData
+# Project Developers. See the top-level COPYRIGHT file for details.
+#
+# SPDX-License-Identifier: MIT
+
+from conftest import DATA_DIR
+
+
+def test_mg_maintain_analytics(metallgraph):
+    metallgraph.maintain_analytics()
+    select_data = metallgraph.select_nodes()
+    by_id = {d["node.id"]: d for d in select_data}
+
+    assert by_id["5clique-a"]["node.maintained_out_degree"] == 4
+    assert by_id["5clique-e"]["node.maintained_in_degree"] == 4
+    path_ccs = {by_id[f"path-{c}"]["node.maintained_cc"] for c in "abcdefg"}
+    assert len(path_ccs) == 1
+    assert len({d["node.maintained_cc"] for d in select_data}) == 4
+
+    # Re-ingesting the same edges doubles every degree and keeps the
+    # components; the series are updated without calling anything else.
+    metallgraph.ingest_parquet_edges(DATA_DIR + "/test", "s", "t")
+    select_data = metallgraph.select_nodes()
+    by_id = {d["node.id"]: d for d in select_data}
+
+    assert by_id["5clique-a"]["node.maintained_out_degree"] == 8
+    assert by_id["5clique-e"]["node.maintained_in_degree"] == 8
+    assert len({d["node.maintained_cc"] for d in select_data}) == 4
+
+
+def test_mg_maintain_analytics_after_erase(metallgraph):
+    metallgraph.maintain_analytics()
+    metallgraph.erase_edges(where=metallgraph.edge.u == "path-c")
+    select_data = metallgraph.select_nodes()
+    by_id = {d["node.id"]: d for d in select_data}
+
+    assert by_id["path-c"]["node.maintained_out_degree"] == 0
+    assert (
+        by_id["path-a"]["node.maintained_cc"] != by_id["path-g"]["node.maintained_cc"]
+    )
@@ -24,3 +24,37 @@ def test_mg_nhops(metallgraph):
     is_specific(select_data, "id", required_result)
     select_data = metallgraph.select_nodes(where=metallgraph.node.gnum != 3)
     is_as_selected(select_data, {}, ["id"], ["nhops"])
+
+
+def test_mg_nhops_after_erase(metallgraph):
+    # The second nhops must see the erased edge, i.e. the cached adjacency is
+    # rebuilt after erase_edges.
+    metallgraph.nhops("before", 2, ["path-a"])
+    metallgraph.erase_edges(where=metallgraph.edge.u == "path-b")
+    metallgraph.nhops("after", 2, ["path-a"])
+    select_data = metallgraph.select_nodes()
+    hops_by_id = {d["node.id"]: d for d in select_data}
+
+    assert hops_by_id["path-b"]["node.before"] == 1
+    assert hops_by_id["path-b"]["node.after"] == 1
+    assert hops_by_id["path-c"]["node.before"] == 2
+    assert "node.after" not in hops_by_id["path-c"]
+
+
+def test_mg_nhops_dense_frontier(metallgraph):
+    # A clique seed expands a frontier large enough to trigger bottom-up
+    # steps, while the path seed stays sparse; both run in the same pass.
+    metallgraph.nhops("nhops", 3, ["5clique-a", "path-a"])
+    select_data = metallgraph.select_nodes()
+    required_result = {
+        "5clique-a": {"node.nhops": 0},
+        "5clique-b": {"node.nhops": 1},
+        "5clique-c": {"node.nhops": 1},
+        "5clique-d": {"node.nhops": 1},
+        "5clique-e": {"node.nhops": 1},
+        "path-a": {"node.nhops": 0},
+        "path-b": {"node.nhops": 1},
+        "path-c": {"node.nhops": 2},
+        "path-d": {"node.nhops": 3},
+    }
+    is_specific(select_data, "node.id", required_result)
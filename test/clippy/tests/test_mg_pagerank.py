@@ -0,0 +1,27 @@
+# Copyright Lawrence Livermore National Security, LLC and other MetallData
+# Project Developers. See the top-level COPYRIGHT file for details.
+#
+# SPDX-License-Identifier: MIT
+
+import pytest
+
+
+def test_mg_pagerank(metallgraph):
+    metallgraph.pagerank("pr")
+    select_data = metallgraph.select_nodes()
+    pr_by_id = {d["node.id"]: d["node.pr"] for d in select_data}
+
+    assert sum(pr_by_id.values()) == pytest.approx(1.0, abs=1e-4)
+    # In the directed 5-clique every node points at all later nodes.
+    assert pr_by_id["5clique-e"] > pr_by_id["5clique-a"]
+    assert pr_by_id["path-g"] > pr_by_id["path-a"]
+
+
+def test_mg_personalized_pagerank(metallgraph):
+    metallgraph.pagerank("ppr", seeds=["path-a"])
+    select_data = metallgraph.select_nodes()
+    pr_by_id = {d["node.id"]: d["node.ppr"] for d in select_data}
+
+    assert sum(pr_by_id.values()) == pytest.approx(1.0, abs=1e-4)
+    assert pr_by_id["path-a"] == max(pr_by_id.values())
+    assert pr_by_id["5clique-a"] == pytest.approx(0.0)
@@ -0,0 +1,32 @@
+# Copyright Lawrence Livermore National Security, LLC and other MetallData
+# Project Developers. See the top-level COPYRIGHT file for details.
+#
+# SPDX-License-Identifier: MIT
+
+import glob
+
+import pytest
+from clippy.backends.fs.execution import NonZeroReturnCodeError  # type: ignore
+
+
+def test_mg_random_walks(metallgraph, tmp_path):
+    out = str(tmp_path / "walks")
+    nv = metallgraph.describe()["nv"]
+
+    # Single-node walks: exactly one row per node.
+    r = metallgraph.random_walks(out, num_walks=1, walk_len=1)
+    assert r["rows_written"] == nv
+    assert len(glob.glob(out + "_*.parquet")) > 0
+
+    # Walks never exceed walk_len nodes.
+    r = metallgraph.random_walks(
+        out, num_walks=2, walk_len=4, p=0.5, q=2.0, seed=7, overwrite=True
+    )
+    assert 2 * nv <= r["rows_written"] <= 2 * 4 * nv
+
+
+def test_mg_random_walks_no_overwrite(metallgraph, tmp_path):
+    out = str(tmp_path / "walks")
+    metallgraph.random_walks(out, num_walks=1, walk_len=2)
+    with pytest.raises(NonZeroReturnCodeError):
+        metallgraph.random_walks(out, num_walks=1, walk_len=2)
@@ -0,0 +1,38 @@
+# Copyright Lawrence Livermore National Security, LLC and other MetallData
+# Project Developers. See the top-level COPYRIGHT file for details.
+#
+# SPDX-License-Identifier: MIT
+
+import pytest
+from clippy.backends.fs.execution import NonZeroReturnCodeError  # type: ignore
+
+from conftest import is_as_described
+
+
+def edge_rows(mg):
+    return sorted(
+        (d["edge.u"], d["edge.v"], d.get("edge.graphnum"))
+        for d in mg.select_edges(limit=0)
+    )
+
+
+def test_mg_repartition_edges(metallgraph):
+    before = metallgraph.describe()
+    rows = edge_rows(metallgraph)
+    metallgraph.out_degree("out1")
+
+    r = metallgraph.repartition_edges(policy="source")
+    assert r["num_edges_moved"] <= before["ne"]
+    is_as_described(metallgraph, before["nv"], before["ne"])
+    assert edge_rows(metallgraph) == rows
+
+    # Already partitioned: nothing moves, results are unchanged.
+    assert metallgraph.repartition_edges()["num_edges_moved"] == 0
+    metallgraph.out_degree("out2")
+    for d in metallgraph.select_nodes():
+        assert d["node.out1"] == d["node.out2"]
+
+
+def test_mg_repartition_edges_bad_policy(metallgraph):
+    with pytest.raises(NonZeroReturnCodeError):
+        metallgraph.repartition_edges(policy="2d")
@@ -0,0 +1,59 @@
+# Copyright Lawrence Livermore National Security, LLC and other MetallData
+# Project Developers. See the top-level COPYRIGHT file for details.
+#
+# SPDX-License-Identifier: MIT
+
+import math
+
+import pytest
+from clippy.backends.fs.execution import NonZeroReturnCodeError  # type: ignore
+
+
+def test_mg_pair_similarity(metallgraph):
+    rows = metallgraph.pair_similarity(
+        pairs=[["5clique-a", "5clique-b"], ["path-a", "path-c"],
+               ["path-a", "nosuchnode"]]
+    )
+    by_pair = {(r["u"], r["v"]): r for r in rows}
+    assert len(by_pair) == 2
+
+    r = by_pair[("5clique-a", "5clique-b")]
+    assert r["common_neighbors"] == 3
+    assert r["jaccard"] == pytest.approx(3 / 5)
+    assert r["adamic_adar"] == pytest.approx(3 / math.log(4))
+
+    r = by_pair[("path-a", "path-c")]
+    assert r["common_neighbors"] == 1
+    assert r["jaccard"] == pytest.approx(1 / 2)
+    assert r["adamic_adar"] == pytest.approx(1 / math.log(2))
+
+
+def test_mg_pair_similarity_two_hop(metallgraph):
+    rows = metallgraph.pair_similarity(limit=0)
+    pairs = {frozenset((r["u"], r["v"])) for r in rows}
+
+    # Two-hop pairs only: clique members are all adjacent.
+    assert not any(all(x.startswith("5clique-") for x in p) for p in pairs)
+    for a, c in zip("abcde", "cdefg"):
+        assert frozenset((f"path-{a}", f"path-{c}")) in pairs
+    assert frozenset(("path-a", "path-b")) not in pairs
+    assert all(r["common_neighbors"] >= 1 for r in rows)
+
+
+def test_mg_edge_similarity(metallgraph):
+    metallgraph.edge_similarity(common="cn", jaccard="jac")
+    for d in metallgraph.select_edges():
+        if d["edge.u"].startswith("5clique-"):
+            assert d["edge.cn"] == 3
+            assert d["edge.jac"] == pytest.approx(3 / 5)
+        if {d["edge.u"], d["edge.v"]} == {"path-a", "path-b"}:
+            assert d["edge.cn"] == 0
+            assert d["edge.jac"] == pytest.approx(0.0)
+        assert "edge.adamic_adar" not in d
+
+
+def test_mg_edge_similarity_duplicate_outputs(metallgraph):
+    with pytest.raises(NonZeroReturnCodeError):
+        metallgraph.edge_similarity(common="x", jaccard="x")
+    for d in metallgraph.select_edges():
+        assert "edge.x" not in d
@@ -0,0 +1,34 @@
+# Copyright Lawrence Livermore National Security, LLC and other MetallData
+# Project Developers. See the top-level COPYRIGHT file for details.
+#
+# SPDX-License-Identifier: MIT
+
+from conftest import is_specific
+
+
+def test_mg_sssp(metallgraph):
+    metallgraph.assign("edge.w", 2)
+    metallgraph.sssp("dist", "w", ["path-a", "5clique-a"])
+    select_data = metallgraph.select_nodes()
+    required_result = {
+        "path-a": {"node.dist": 0.0},
+        "path-b": {"node.dist": 2.0},
+        "path-c": {"node.dist": 4.0},
+        "path-g": {"node.dist": 12.0},
+        "5clique-a": {"node.dist": 0.0},
+        "5clique-e": {"node.dist": 2.0},
+    }
+    is_specific(select_data, "node.id", required_result)
+
+
+def test_mg_sssp_max_dist(metallgraph):
+    metallgraph.assign("edge.w", 2)
+    metallgraph.sssp("dist", "w", ["path-a"], max_dist=5.0)
+    select_data = metallgraph.select_nodes()
+    dist_by_id = {d["node.id"]: d for d in select_data}
+
+    assert dist_by_id["path-c"]["node.dist"] == 4.0
+    assert "node.dist" not in dist_by_id["path-d"]
+    for d in select_data:
+        if "node.dist" in d:
+            assert d["node.dist"] <= 5.0
@@ -0,0 +1,44 @@
+# Copyright Lawrence Livermore National Security, LLC and other MetallData
+# Project Developers. See the top-level COPYRIGHT file for details.
+#
+# SPDX-License-Identifier: MIT
+
+from conftest import DATA_DIR
+
+
+def test_mg_scc_dag(metallgraph):
+    # The directed clique and path are acyclic, so every node is its own
+    # strongly connected component, unlike the weak components.
+    metallgraph.strongly_connected_components("scc")
+    select_data = metallgraph.select_nodes()
+    scc_by_id = {d["node.id"]: d["node.scc"] for d in select_data}
+
+    for c in "abcde":
+        assert scc_by_id[f"5clique-{c}"] == f"5clique-{c}"
+    for c in "abcdefg":
+        assert scc_by_id[f"path-{c}"] == f"path-{c}"
+
+
+def test_mg_scc_label_is_member(metallgraph):
+    metallgraph.strongly_connected_components("scc")
+    select_data = metallgraph.select_nodes()
+    scc_by_id = {d["node.id"]: d["node.scc"] for d in select_data}
+
+    for label in scc_by_id.values():
+        assert scc_by_id[label] == label
+
+
+def test_mg_scc_after_ingest(metallgraph):
+    # Builds the persistent forward and reverse adjacencies.
+    metallgraph.strongly_connected_components("scc1")
+
+    # Adding every edge reversed, which extends both adjacencies in place,
+    # makes each connected group strongly connected.
+    metallgraph.ingest_parquet_edges(DATA_DIR + "/test", "t", "s")
+    metallgraph.strongly_connected_components("scc2")
+    select_data = metallgraph.select_nodes()
+    scc_by_id = {d["node.id"]: d["node.scc2"] for d in select_data}
+
+    assert len({scc_by_id[f"5clique-{c}"] for c in "abcde"}) == 1
+    assert len({scc_by_id[f"path-{c}"] for c in "abcdefg"}) == 1
+    assert scc_by_id["5clique-a"] != scc_by_id["path-a"]
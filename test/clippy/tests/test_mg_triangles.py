@@ -0,0 +1,29 @@
+# Copyright Lawrence Livermore National Security, LLC and other MetallData
+# Project Developers. See the top-level COPYRIGHT file for details.
+#
+# SPDX-License-Identifier: MIT
+
+import pytest
+
+
+def test_mg_triangle_count(metallgraph):
+    metallgraph.triangle_count("tri")
+    select_data = metallgraph.select_nodes()
+    tri_by_id = {d["node.id"]: d["node.tri"] for d in select_data}
+
+    # Every node of a k-clique is in (k-1 choose 2) triangles.
+    for c in "abcde":
+        assert tri_by_id[f"5clique-{c}"] == 6
+    for c in "abcdefg":
+        assert tri_by_id[f"path-{c}"] == 0
+
+
+def test_mg_clustering_coefficient(metallgraph):
+    metallgraph.clustering_coefficient("ccoef")
+    select_data = metallgraph.select_nodes()
+    cc_by_id = {d["node.id"]: d["node.ccoef"] for d in select_data}
+
+    for c in "abcde":
+        assert cc_by_id[f"5clique-{c}"] == pytest.approx(1.0)
+    assert cc_by_id["path-a"] == pytest.approx(0.0)
+    assert cc_by_id["path-c"] == pytest.approx(0.0)
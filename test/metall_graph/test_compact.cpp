@@ -0,0 +1,133 @@
+// Copyright Lawrence Livermore National Security, LLC and other MetallData
+// Project Developers. See the top-level COPYRIGHT file for details.
+//
+// SPDX-License-Identifier: MIT
+
+#undef NDEBUG
+
+#include <filesystem>
+#include <map>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <ygm/comm.hpp>
+#include <ygm/detail/collective.hpp>
+#include <metalldata/metall_graph.hpp>
+#include <ygm/utility/assert.hpp>
+
+// Get the path to the data directory from CMake
+std::filesystem::path data_path = CMAKE_DATA_PATH;
+
+namespace metalldata {
+class metall_graph_test {
+ public:
+  // Removes the node records of the "-a" and "-c" nodes of the five-clique
+  // and the two triangles, wherever they live, and checks that compact()
+  // drops their edges and remaps the rest.
+  void run_test(ygm::comm& comm) {
+    std::filesystem::path parquet_path = data_path / "metall_graph/pqmulti";
+    std::string           metall_path = "compactnodes";
+
+    if (comm.layout().local_id() == 0) {
+      std::filesystem::remove_all(metall_path);
+    }
+    comm.barrier();
+    metalldata::metall_graph test(comm, metall_path);
+    auto ret_ingest =
+      test.ingest_parquet_edges(parquet_path.string(), false, "s", "t", true);
+    if (!ret_ingest) {
+      comm.cout(ret_ingest.error());
+      MPI_Abort(comm.get_mpi_comm(), 1);
+    }
+
+    auto removed = [](std::string_view label) {
+      return label.ends_with("-a") || label.ends_with("-c");
+    };
+
+    size_t removed_nodes = 0;
+    test.priv_for_all_nodes([&](metall_graph::local_node_idx_type nid) {
+      if (removed(test.pl_get_node_label(nid))) {
+        test.m_pnodes->remove_record(std::to_underlying(nid));
+        ++removed_nodes;
+      }
+    });
+    size_t surviving_edges = 0;
+    test.priv_for_all_edges([&](metall_graph::local_edge_idx_type eid) {
+      auto [u, v] = test.pl_get_edge_uv_labels(eid);
+      if (!removed(u) && !removed(v)) {
+        ++surviving_edges;
+      }
+    });
+    removed_nodes = ygm::sum(removed_nodes, comm);
+    surviving_edges = ygm::sum(surviving_edges, comm);
+    YGM_ASSERT_RELEASE(removed_nodes > 0);
+
+    auto ret_compact = test.compact();
+    if (!ret_compact) {
+      comm.cout(ret_compact.error());
+      MPI_Abort(comm.get_mpi_comm(), 1);
+    }
+    YGM_ASSERT_RELEASE(ret_compact.value().at("num_node_slots_removed") ==
+                       removed_nodes);
+    YGM_ASSERT_RELEASE(test.m_pnodes->num_record_slots() ==
+                       test.m_pnodes->num_records());
+    YGM_ASSERT_RELEASE(test.m_pedges->num_record_slots() ==
+                       test.m_pedges->num_records());
+    YGM_ASSERT_RELEASE(ygm::sum(test.pl_num_edges(), comm) == surviving_edges);
+
+    //
+    // Every surviving label is indexed, and the U/V locator series agree
+    // with the labels and their owners.
+    auto ret_check = test.priv_check_index_integrity();
+    if (!ret_check || !ret_check.warnings().empty()) {
+      comm.cout("index integrity check failed after compact()");
+      MPI_Abort(comm.get_mpi_comm(), 1);
+    }
+    test.priv_for_all_nodes([&](metall_graph::local_node_idx_type nid) {
+      YGM_ASSERT_RELEASE(!removed(test.pl_get_node_label(nid)));
+    });
+
+    //
+    // Degrees from the rebuilt adjacency match the edges' labels.
+    std::map<std::string, std::pair<int64_t, int64_t>>         expected;
+    static std::map<std::string, std::pair<int64_t, int64_t>>* sp_expected =
+      nullptr;
+    sp_expected = &expected;
+    comm.barrier();
+    test.priv_for_all_edges([&](metall_graph::local_edge_idx_type eid) {
+      auto [u, v] = test.pl_get_edge_uv_labels(eid);
+      comm.async(
+        test.m_partitioner.owner(u),
+        [](const std::string& label) { ++(*sp_expected)[label].second; },
+        std::string(u));
+      comm.async(
+        test.m_partitioner.owner(v),
+        [](const std::string& label) { ++(*sp_expected)[label].first; },
+        std::string(v));
+    });
+    comm.barrier();
+    sp_expected = nullptr;
+
+    auto [indeg, outdeg] = test.priv_degrees(metall_graph::where_clause());
+    test.priv_for_all_nodes([&](metall_graph::local_node_idx_type nid) {
+      auto i = std::to_underlying(nid);
+      auto it = expected.find(std::string(test.pl_get_node_label(nid)));
+      auto [in, out] =
+        it == expected.end() ? std::pair<int64_t, int64_t>{} : it->second;
+      YGM_ASSERT_RELEASE(indeg[i] == in);
+      YGM_ASSERT_RELEASE(outdeg[i] == out);
+    });
+  }
+};
+}  // namespace metalldata
+
+int main(int argc, char** argv) {
+  ygm::comm world(&argc, &argv);
+
+  metalldata::metall_graph_test mgt;
+
+  mgt.run_test(world);
+  return 0;
+}
@@ -0,0 +1,141 @@
+// Copyright Lawrence Livermore National Security, LLC and other MetallData
+// Project Developers. See the top-level COPYRIGHT file for details.
+//
+// SPDX-License-Identifier: MIT
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+
+#include <ygm/comm.hpp>
+#include <metall/metall.hpp>
+#include <metall/utility/metall_mpi_adaptor.hpp>
+#include <metalldata/metall_graph.hpp>
+#include <multiseries/legacy_record_store.hpp>
+#include <multiseries/multiseries_record.hpp>
+
+namespace {
+
+using series_name = metalldata::metall_graph::series_name;
+using alloc_type = metall::manager::allocator_type<std::byte>;
+using store_type = multiseries::basic_record_store<alloc_type>;
+using legacy_store_type = multiseries::legacy::record_store_v0<alloc_type>;
+using multiseries::container_kind;
+
+ygm::comm* g_comm = nullptr;
+
+const std::string metall_path = "record_store_migration";
+
+/// Replaces the "nodes" and "edges" stores of a fresh metall_graph with
+/// layout version 0 stores and drops the layout tag, as an older version
+/// would have left them.
+void write_v0_stores() {
+  metall::utility::metall_mpi_adaptor adaptor(metall::open_only, metall_path,
+                                              g_comm->get_mpi_comm());
+  auto& manager = adaptor.get_local_manager();
+  auto* strings =
+    manager.find<store_type::string_store_type>(metall::unique_instance).first;
+  ASSERT_NE(strings, nullptr);
+  manager.destroy<store_type>("nodes");
+  manager.destroy<store_type>("edges");
+  manager.destroy<uint32_t>("record_store_layout");
+
+  auto* nodes = manager.construct<legacy_store_type>("nodes")(
+    strings, manager.get_allocator());
+  auto id = nodes->add_series<std::string_view>(
+    series_name::NODE_COL.unqualified(), container_kind::dense);
+  auto age = nodes->add_series<int64_t>("age", container_kind::dense);
+  auto city = nodes->add_series<std::string_view>("city",
+                                                  container_kind::sparse);
+  auto flag = nodes->add_series<bool>("flag", container_kind::dense);
+  for (int64_t i = 0; i < 4; ++i) {
+    auto rid = nodes->add_record();
+    nodes->set(id, rid, std::string_view("node-" + std::to_string(i)));
+    nodes->set(age, rid, 10 * i);
+    nodes->set(flag, rid, i % 2 == 0);
+  }
+  nodes->set(city, 1, std::string_view("Livermore"));
+  nodes->set(city, 3, std::string_view("Chicago"));
+  nodes->remove_record(2);
+
+  auto* edges = manager.construct<legacy_store_type>("edges")(
+    strings, manager.get_allocator());
+  edges->add_series<std::string_view>(series_name::U_COL.unqualified(),
+                                      container_kind::dense);
+  edges->add_series<std::string_view>(series_name::V_COL.unqualified(),
+                                      container_kind::dense);
+  edges->add_series<bool>(series_name::DIR_COL.unqualified(),
+                          container_kind::dense);
+  edges->add_series<int64_t>(series_name::U_LOC_COL.unqualified(),
+                             container_kind::dense);
+  edges->add_series<int64_t>(series_name::V_LOC_COL.unqualified(),
+                             container_kind::dense);
+}
+
+}  // namespace
+
+TEST(RecordStoreMigrationTest, MigratesLayoutVersion0) {
+  if (g_comm->layout().local_id() == 0) {
+    std::filesystem::remove_all(metall_path);
+  }
+  g_comm->barrier();
+  { metalldata::metall_graph graph(*g_comm, metall_path, true); }
+  write_v0_stores();
+
+  {
+    metalldata::metall_graph graph(*g_comm, metall_path);
+    EXPECT_TRUE(graph.has_series(series_name("node.age")));
+    EXPECT_TRUE(graph.has_series(series_name("node.city")));
+    EXPECT_TRUE(graph.has_series(series_name("node.flag")));
+  }
+
+  metall::utility::metall_mpi_adaptor adaptor(metall::open_read_only,
+                                              metall_path,
+                                              g_comm->get_mpi_comm());
+  auto& manager = adaptor.get_local_manager();
+  auto* layout = manager.find<uint32_t>("record_store_layout").first;
+  ASSERT_NE(layout, nullptr);
+  EXPECT_EQ(*layout, store_type::k_layout_version);
+  EXPECT_EQ(manager.find<store_type>("nodes.migrating").first, nullptr);
+
+  const auto* nodes = manager.find<store_type>("nodes").first;
+  ASSERT_NE(nodes, nullptr);
+  EXPECT_EQ(nodes->num_record_slots(), 4u);
+  EXPECT_EQ(nodes->num_records(), 3u);
+  EXPECT_FALSE(nodes->contains_record(2));
+
+  auto id = nodes->find_series(series_name::NODE_COL.unqualified()).value();
+  auto age = nodes->find_series("age").value();
+  auto city = nodes->find_series("city").value();
+  auto flag = nodes->find_series("flag").value();
+  EXPECT_TRUE(nodes->is_series_type<int64_t>(age));
+  EXPECT_TRUE(nodes->is_series_type<bool>(flag));
+  for (size_t i : {0, 1, 3}) {
+    EXPECT_TRUE(nodes->contains_record(i));
+    EXPECT_EQ(nodes->get<std::string_view>(id, i).value(),
+              "node-" + std::to_string(i));
+    EXPECT_EQ(nodes->get<int64_t>(age, i).value(), int64_t(10 * i));
+    EXPECT_EQ(nodes->get<bool>(flag, i).value(), i % 2 == 0);
+  }
+  EXPECT_FALSE(nodes->get<std::string_view>(city, 0).has_value());
+  EXPECT_EQ(nodes->get<std::string_view>(city, 1).value(), "Livermore");
+  EXPECT_EQ(nodes->get<std::string_view>(city, 3).value(), "Chicago");
+
+  const auto* edges = manager.find<store_type>("edges").first;
+  ASSERT_NE(edges, nullptr);
+  EXPECT_EQ(edges->num_records(), 0u);
+  EXPECT_TRUE(
+    edges->find_series(series_name::U_COL.unqualified()).has_value());
+}
+
+int main(int argc, char** argv) {
+  ygm::comm world(&argc, &argv);
+  g_comm = &world;
+  ::testing::InitGoogleTest(&argc, argv);
+  int result = RUN_ALL_TESTS();
+  g_comm = nullptr;
+  return result;
+}
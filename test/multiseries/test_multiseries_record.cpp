@@ -5,7 +5,10 @@
 
 #include <gtest/gtest.h>
 #include <multiseries/multiseries_record.hpp>
+#include <algorithm>
+#include <span>
 #include <unordered_map>
+#include <vector>
 
 using namespace multiseries;
 
@@ -219,4 +222,192 @@ TEST(MultiSeriesTest, RemoveSeriesAndRecords) {
   EXPECT_TRUE(store.is_none(series_indices["city"], 0));
   EXPECT_TRUE(store.is_none(series_indices["flag"], 0));
   EXPECT_EQ(store.num_series(), 3);
-}
\ No newline at end of file
+}
+
+TEST(MultiSeriesTest, FindSeriesAfterRemoveAndRename) {
+  record_store::string_store_type string_store;
+  record_store                    store(&string_store);
+
+  initialize_store(store);
+  EXPECT_EQ(store.find_series("city").value(), 2);
+  EXPECT_EQ(store.add_series<int64_t>("age"), 1);
+
+  // Indices after the removed series shift down.
+  EXPECT_TRUE(store.remove_series("name"));
+  EXPECT_FALSE(store.find_series("name").has_value());
+  EXPECT_EQ(store.find_series("age").value(), 0);
+  EXPECT_EQ(store.find_series("city").value(), 1);
+  EXPECT_EQ(store.find_series("flag").value(), 2);
+  EXPECT_EQ(store.get<int64_t>(store.find_series("age").value(), 3).value(),
+            ages[3]);
+
+  EXPECT_TRUE(store.rename_series("city", "town"));
+  EXPECT_FALSE(store.contains_series("city"));
+  EXPECT_EQ(store.find_series("town").value(), 1);
+  EXPECT_FALSE(store.rename_series("town", "flag"));
+  EXPECT_FALSE(store.rename_series("city", "village"));
+
+  EXPECT_EQ(store.add_series<double>("name"), 3);
+  EXPECT_EQ(store.find_series("name").value(), 3);
+  EXPECT_EQ(store.num_series(), 4);
+}
+
+TEST(MultiSeriesTest, LiveRecordsAcrossWords) {
+  record_store::string_store_type string_store;
+  record_store                    store(&string_store);
+
+  const auto idx = store.add_series<int64_t>("id");
+  for (int64_t i = 0; i < 200; ++i) {
+    store.set(idx, store.add_record(), i);
+  }
+  EXPECT_EQ(store.num_records(), 200);
+
+  // Empty the second word entirely and thin out the rest.
+  for (size_t i = 0; i < 200; ++i) {
+    if ((i >= 64 && i < 128) || i % 3 == 0) {
+      EXPECT_TRUE(store.remove_record(i));
+    }
+  }
+  EXPECT_TRUE(store.remove_record(3));  // already removed
+  EXPECT_FALSE(store.remove_record(200));
+  EXPECT_EQ(store.num_record_slots(), 200);
+
+  std::vector<size_t> visited;
+  store.for_all_rows([&](size_t i) { visited.push_back(i); });
+  std::vector<size_t> expected;
+  for (size_t i = 0; i < 200; ++i) {
+    if (!((i >= 64 && i < 128) || i % 3 == 0)) {
+      expected.push_back(i);
+      EXPECT_TRUE(store.contains_record(i));
+    } else {
+      EXPECT_FALSE(store.contains_record(i));
+    }
+  }
+  EXPECT_EQ(visited, expected);
+  EXPECT_EQ(store.num_records(), expected.size());
+
+  const auto rid = store.add_record();
+  EXPECT_EQ(rid, 200);
+  EXPECT_EQ(store.num_records(), expected.size() + 1);
+}
+
+TEST(MultiSeriesTest, DenseValidityAndPackedBool) {
+  record_store::string_store_type string_store;
+  record_store                    store(&string_store);
+
+  const auto bidx = store.add_series<bool>("b");
+  const auto didx = store.add_series<double>("d");
+  for (size_t i = 0; i < 130; ++i) {
+    store.add_record();
+  }
+  // Leave gaps so validity and value bits differ.
+  for (size_t i = 0; i < 130; i += 2) {
+    store.set(bidx, i, i % 4 == 0);
+    store.set(didx, i, double(i) / 2);
+  }
+  store.set(bidx, 0, false);  // overwrite a set bit
+  EXPECT_EQ(store.size("b"), 65);
+  EXPECT_EQ(store.size("d"), 65);
+
+  for (size_t i = 0; i < 130; ++i) {
+    if (i % 2 == 1) {
+      EXPECT_TRUE(store.is_none(bidx, i));
+      EXPECT_TRUE(store.is_none(didx, i));
+      continue;
+    }
+    EXPECT_EQ(store.get<bool>(bidx, i).value(), i != 0 && i % 4 == 0);
+    EXPECT_EQ(store.get<double>(didx, i).value(), double(i) / 2);
+  }
+
+  EXPECT_TRUE(store.remove(bidx, 4));
+  EXPECT_FALSE(store.remove(bidx, 4));
+  EXPECT_TRUE(store.is_none(bidx, 4));
+  EXPECT_EQ(store.size("b"), 64);
+
+  store.convert(bidx, multiseries::container_kind::sparse);
+  store.convert(bidx, multiseries::container_kind::dense);
+  EXPECT_EQ(store.size("b"), 64);
+  EXPECT_TRUE(store.is_none(bidx, 4));
+  EXPECT_FALSE(store.get<bool>(bidx, 2).value());
+  EXPECT_TRUE(store.get<bool>(bidx, 128).value());
+}
+
+TEST(MultiSeriesTest, ForEachChunk) {
+  record_store::string_store_type string_store;
+  record_store                    store(&string_store);
+
+  const auto idx = store.add_series<int64_t>("v");
+  const size_t n = 10000;
+  for (size_t i = 0; i < n; ++i) {
+    store.add_record();
+    if (i % 7 != 0) {
+      store.set(idx, i, int64_t(i));
+    }
+  }
+  store.remove_record(5);
+
+  auto scan = [&store, idx]() {
+    std::vector<int64_t> seen;
+    store.for_each_chunk<int64_t>(
+      idx, [&](std::span<const int64_t> vals,
+               std::span<const uint64_t> validity, size_t base) {
+        for (size_t j = 0; j < vals.size(); ++j) {
+          if (validity[j / 64] & (uint64_t(1) << (j % 64))) {
+            EXPECT_EQ(vals[j], int64_t(base + j));
+            seen.push_back(vals[j]);
+          }
+        }
+      });
+    std::sort(seen.begin(), seen.end());
+    return seen;
+  };
+
+  std::vector<int64_t> expected;
+  for (size_t i = 0; i < n; ++i) {
+    if (i % 7 != 0 && i != 5) {
+      expected.push_back(int64_t(i));
+    }
+  }
+  EXPECT_EQ(scan(), expected);
+
+  store.convert(idx, multiseries::container_kind::sparse);
+  EXPECT_EQ(scan(), expected);
+}
+
+TEST(MultiSeriesTest, Compact) {
+  record_store::string_store_type string_store;
+  record_store                    store(&string_store);
+
+  auto series_indices = initialize_store(store);
+  store.convert(series_indices["city"], multiseries::container_kind::sparse);
+  store.remove_record(1);
+  store.remove_record(3);
+  const auto bytes_before = store.storage_bytes();
+
+  const auto new_ids = store.compact();
+  ASSERT_EQ(new_ids.size(), 5);
+  EXPECT_EQ(new_ids[0], 0);
+  EXPECT_EQ(new_ids[1], record_store::k_removed_record);
+  EXPECT_EQ(new_ids[2], 1);
+  EXPECT_EQ(new_ids[3], record_store::k_removed_record);
+  EXPECT_EQ(new_ids[4], 2);
+  EXPECT_LT(store.storage_bytes(), bytes_before);
+
+  EXPECT_EQ(store.num_records(), 3);
+  EXPECT_EQ(store.num_record_slots(), 3);
+  for (size_t old : {0, 2, 4}) {
+    const auto rid = new_ids[old];
+    EXPECT_TRUE(store.contains_record(rid));
+    EXPECT_EQ(store.get<std::string_view>(series_indices["name"], rid).value(),
+              names[old]);
+    EXPECT_EQ(store.get<int64_t>(series_indices["age"], rid).value(),
+              ages[old]);
+    EXPECT_EQ(store.get<std::string_view>(series_indices["city"], rid).value(),
+              cities[old]);
+    EXPECT_EQ(store.get<bool>(series_indices["flag"], rid).value(),
+              flags[old]);
+  }
+  EXPECT_EQ(store.size("age"), 3);
+  EXPECT_EQ(store.size("city"), 3);
+  EXPECT_EQ(store.add_record(), 3);
+}
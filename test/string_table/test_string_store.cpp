@@ -6,6 +6,8 @@
 #include <gtest/gtest.h>
 
 #include <cstring>
+#include <string>
+#include <vector>
 #include <metall/metall.hpp>
 
 #include <string_table/string_store.hpp>
@@ -83,4 +85,27 @@ TEST(StringTableTest, AddString) {
       EXPECT_STREQ(accessor.c_str(), str.c_str());
     }
   }
-}
\ No newline at end of file
+}
+
+TEST(StringTableTest, AddAll) {
+  {
+    metall::manager manager(metall::create_only, "/tmp/metall-test");
+    auto *store = manager.construct<store_type>(metall::unique_instance)(
+      manager.get_allocator());
+
+    const char *existing = store->find_or_add("key0");
+
+    std::vector<std::string> strs;
+    for (int i = 0; i < 100; ++i) {
+      strs.push_back("key" + std::to_string(i % 50));
+    }
+    store->add_all(strs.begin(), strs.end());
+
+    EXPECT_EQ(store->size(), size_t(50));
+    EXPECT_EQ(store->find("key0"), existing);  // Not reallocated
+    for (int i = 0; i < 50; ++i) {
+      std::string key = "key" + std::to_string(i);
+      EXPECT_STREQ(store->find(key), key.c_str());
+    }
+  }
+}